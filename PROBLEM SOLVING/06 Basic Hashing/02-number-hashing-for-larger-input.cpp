@@ -1,4 +1,5 @@
 #include <bits/stdc++.h>
+#include "frequency-counter.h"
 using namespace std;
 
 /*
@@ -18,35 +19,26 @@ Output:
   element -> frequency
 
 Note:
-- Output order is not guaranteed (unordered_map is used)
+- Output order is not guaranteed (hash table is used)
+- Large arrays are counted on all cores with countFrequencies (frequency-counter.h)
 */
 
 // Function to print frequency of elements in an array
 void printFrequency(const vector<int> &arr)
 {
-    // Step 4: Create an unordered_map to store frequency
+    // Step 4 + 5: Count frequency of each element
     // Key   -> number from array
     // Value -> how many times that number appears
-    // unordered_map gives average O(1) insertion & lookup
-    unordered_map<int, int> freq;
-
-    // Step 5: Count frequency of each element
-    // Range-based for loop iterates over each element in arr
-    for (int x : arr)
-    {
-        // If x is already present, increment its count
-        // If not present, it is created with initial value 0,
-        // then incremented to 1
-        freq[x]++;
-    }
-
-    // Step 6: Print the frequency map
-    // 'it.first'  -> key (array element)
-    // 'it.second' -> value (frequency)
-    for (auto it : freq)
-    {
-        cout << it.first << " -> " << it.second << "\n";
-    }
+    // countFrequencies splits arr across threads:
+    // - small value range → direct address table (hash[x - min]++)
+    // - otherwise         → per-thread hash tables merged partition by partition
+    FrequencyCounts freq = countFrequencies(arr);
+
+    // Step 6: Print the frequency table
+    // 'key'   -> array element
+    // 'count' -> frequency
+    freq.forEach([](int key, uint64_t count)
+                 { cout << key << " -> " << count << "\n"; });
 }
 
 int main()
@@ -78,4 +70,12 @@ int main()
 // Time Complexity: O(n) average
 // Space Complexity: O(n) (for hashmap)
 
-// Since the values are not in a fixed range, unordered_map is preferred over an array for frequency counting.
\ No newline at end of file
+// Since the values are not in a fixed range, a hash table is preferred over an array for frequency counting.
+
+// Large Input (countFrequencies)
+
+// One unordered_map on one thread → every insert is a cache miss, one core busy.
+// Split the array across T threads, each counting into its own small flat tables
+// (one per partition = top bits of hash(x)), then merge partition p of every
+// thread on one thread. No locks in either phase → scales with the core count.
+// If max - min is small, the direct address table (hash[x - min]++) is used instead.
\ No newline at end of file
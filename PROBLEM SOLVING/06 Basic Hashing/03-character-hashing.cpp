@@ -1,4 +1,5 @@
 #include <bits/stdc++.h>
+#include "byte-histogram.h"
 using namespace std;
 
 /*
@@ -11,27 +12,26 @@ We will handle THREE cases:
 1) Only lowercase letters (a–z)
 2) Only uppercase letters (A–Z)
 3) Mixed characters (ASCII based hashing)
+
+All three count with the shared byteHistogram kernel (byte-histogram.h):
+one pass fills a 256-entry table, then each case prints the part it needs.
 */
 
 /* -------------------------------------------------- */
 /* 1️⃣ ONLY LOWERCASE LETTERS (a–z) */
 /* -------------------------------------------------- */
 
-void lowercaseHashing(string s)
+void lowercaseHashing(string_view s)
 {
-    int hash[26] = {0};
-
-    for (char c : s)
-    {
-        hash[c - 'a']++;
-    }
+    uint64_t hash[256];
+    byteHistogram(s, hash);
 
     cout << "Lowercase character frequency:\n";
-    for (int i = 0; i < 26; i++)
+    for (int i = 'a'; i <= 'z'; i++)
     {
         if (hash[i] > 0)
         {
-            cout << char(i + 'a') << " -> " << hash[i] << endl;
+            cout << char(i) << " -> " << hash[i] << endl;
         }
     }
 }
@@ -40,21 +40,17 @@ void lowercaseHashing(string s)
 /* 2️⃣ ONLY UPPERCASE LETTERS (A–Z) */
 /* -------------------------------------------------- */
 
-void uppercaseHashing(string s)
+void uppercaseHashing(string_view s)
 {
-    int hash[26] = {0};
-
-    for (char c : s)
-    {
-        hash[c - 'A']++;
-    }
+    uint64_t hash[256];
+    byteHistogram(s, hash);
 
     cout << "\nUppercase character frequency:\n";
-    for (int i = 0; i < 26; i++)
+    for (int i = 'A'; i <= 'Z'; i++)
     {
         if (hash[i] > 0)
         {
-            cout << char(i + 'A') << " -> " << hash[i] << endl;
+            cout << char(i) << " -> " << hash[i] << endl;
         }
     }
 }
@@ -63,15 +59,11 @@ void uppercaseHashing(string s)
 /* 3️⃣ MIXED CHARACTERS (ASCII HASHING) */
 /* -------------------------------------------------- */
 
-void asciiHashing(string s)
+void asciiHashing(string_view s)
 {
-    // ASCII range: 0 to 255
-    int hash[256] = {0};
-
-    for (char c : s)
-    {
-        hash[(int)c]++;
-    }
+    // Byte range: 0 to 255 (indexed as unsigned char, so bytes >= 128 are safe)
+    uint64_t hash[256];
+    byteHistogram(s, hash);
 
     cout << "\nASCII character frequency:\n";
     for (int i = 0; i < 256; i++)
@@ -126,6 +118,14 @@ Space: O(1) → constant
 Lower / Upper → O(26) → constant
 ASCII → O(256) → constant
 
+Large inputs (byteHistogram)
+
+hash[c]++ on "aaaa..." → each increment waits for the previous store.
+Fix: 4 sub-tables, byte i goes to table i % 4, add them at the end.
+Run skipping (AVX2): one compare per 32 bytes finds a block of one repeated byte → one add of 32
+(the counting is still scalar; only the run check uses AVX2).
+Many MB of input → one histogram per thread, summed at the end.
+
 Interview One-Liners (Very Important)
 
 Lowercase only? → Use int hash[26]
@@ -10,46 +10,268 @@ Your task is to:
 2) Resolve collisions using chaining.
 3) Print the hash table.
 4) Search for a given element (18).
+5) Grow the table when chains get long, WITHOUT one slow insert that
+   rehashes everything at once (incremental resizing).
+
+Run with:  ./a.out             → demo
+           ./a.out --latency   → insert latency: stop-the-world vs incremental
 */
 
-int main()
+// Bucket array allocated in segments of 256 chains on first write, so making
+// (or freeing) a big table never has to touch all of its buckets at once
+class BucketArray
 {
-    vector<int> arr = {28, 38, 48, 18, 8, 22, 32, 42, 52, 62};
-    int tableSize = 10;
+    static const size_t SEGMENT = 256;
+    vector<unique_ptr<vector<int>[]>> segments;
+    size_t buckets = 0;
 
-    vector<vector<int>> hashTable(tableSize);
+public:
+    BucketArray(size_t n = 0) : segments((n + SEGMENT - 1) / SEGMENT), buckets(n) {}
 
-    // Insert elements using division method
-    for (int x : arr)
+    size_t size() const { return buckets; }
+
+    // Chain at index i, or nullptr if its segment was never written
+    const vector<int> *find(size_t i) const
     {
-        int index = x % tableSize;
-        hashTable[index].push_back(x);
+        const unique_ptr<vector<int>[]> &segment = segments[i / SEGMENT];
+        return segment ? &segment[i % SEGMENT] : nullptr;
     }
 
-    // Print hash table
-    for (int i = 0; i < tableSize; i++)
+    vector<int> &at(size_t i)
     {
-        cout << "Index " << i << ": ";
-        for (int val : hashTable[i])
+        unique_ptr<vector<int>[]> &segment = segments[i / SEGMENT];
+        if (!segment)
         {
-            cout << val << " ";
+            segment.reset(new vector<int>[SEGMENT]);
+        }
+        return segment[i % SEGMENT];
+    }
+
+    // Free the segment holding index i (all its chains must be emptied already)
+    void release(size_t i)
+    {
+        segments[i / SEGMENT].reset();
+    }
+
+    static bool endsSegment(size_t i)
+    {
+        return (i + 1) % SEGMENT == 0;
+    }
+};
+
+class ChainedHashTable
+{
+    BucketArray hashTable; // current table (the bigger one while resizing)
+    BucketArray oldTable;  // table being emptied, size 0 when not resizing
+    size_t moved = 0;      // buckets of oldTable already moved
+    size_t count = 0;
+    bool incremental;
+
+    static const int MAX_LOAD = 1;  // grow when size > MAX_LOAD * tableSize
+    static const int MOVE_STEP = 2; // old buckets moved per insert
+
+    // Division method; + tableSize keeps negative numbers in range
+    static size_t indexOf(int x, size_t tableSize)
+    {
+        long long r = x % (long long)tableSize;
+        return (size_t)(r < 0 ? r + (long long)tableSize : r);
+    }
+
+    bool resizing() const
+    {
+        return oldTable.size() > 0;
+    }
+
+    // Move up to 'buckets' old buckets into the new table
+    void moveBuckets(size_t buckets)
+    {
+        while (buckets-- > 0 && resizing())
+        {
+            if (oldTable.find(moved) && !oldTable.at(moved).empty())
+            {
+                vector<int> &chain = oldTable.at(moved);
+                size_t target = indexOf(chain[0], hashTable.size());
+                bool together = all_of(chain.begin(), chain.end(), [&](int val)
+                                       { return indexOf(val, hashTable.size()) == target; });
+                if (together && hashTable.at(target).empty())
+                {
+                    hashTable.at(target).swap(chain); // hand the chain over, no copy or allocation
+                }
+                else
+                {
+                    for (int val : chain)
+                    {
+                        hashTable.at(indexOf(val, hashTable.size())).push_back(val);
+                    }
+                }
+                vector<int>().swap(chain); // free the old chain now, one at a time
+            }
+            if (BucketArray::endsSegment(moved) || moved + 1 == oldTable.size())
+            {
+                oldTable.release(moved);
+            }
+            if (++moved == oldTable.size())
+            {
+                oldTable = BucketArray();
+                moved = 0;
+            }
+        }
+    }
+
+    void startResize()
+    {
+        oldTable = move(hashTable);
+        hashTable = BucketArray(oldTable.size() * 2);
+        moved = 0;
+        if (!incremental)
+        {
+            moveBuckets(oldTable.size()); // stop-the-world: everything now
+        }
+    }
+
+    static bool chainHas(const vector<int> *chain, int key)
+    {
+        if (chain)
+        {
+            for (int val : *chain)
+            {
+                if (val == key)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    static void printChain(const vector<int> *chain)
+    {
+        if (chain)
+        {
+            for (int val : *chain)
+            {
+                cout << val << " ";
+            }
         }
         cout << endl;
     }
 
-    // Search for element 18
-    int key = 18;
-    int index = key % tableSize;
+public:
+    // incremental = false rehashes everything in one insert (for comparison)
+    ChainedHashTable(int tableSize = 10, bool incremental = true)
+        : hashTable(max(tableSize, 1)), incremental(incremental) {}
 
-    for (int val : hashTable[index])
+    // Each insert also moves MOVE_STEP old buckets, so a resize is spread over
+    // many inserts. It always finishes before the next one is due: the new
+    // table has twice the buckets, so it takes tableSize more inserts to fill.
+    void insert(int x)
     {
-        if (val == key)
+        moveBuckets(MOVE_STEP);
+        hashTable.at(indexOf(x, hashTable.size())).push_back(x);
+        count++;
+        if (!resizing() && count > MAX_LOAD * hashTable.size())
         {
-            cout << "Found: " << val << endl;
-            break;
+            startResize();
         }
     }
 
+    // During a resize a key may still be in its old bucket: check both tables
+    bool search(int key) const
+    {
+        if (chainHas(hashTable.find(indexOf(key, hashTable.size())), key))
+        {
+            return true;
+        }
+        if (resizing())
+        {
+            size_t index = indexOf(key, oldTable.size());
+            return index >= moved && chainHas(oldTable.find(index), key); // buckets before 'moved' are gone
+        }
+        return false;
+    }
+
+    size_t size() const { return count; }
+    size_t tableSize() const { return hashTable.size(); }
+
+    void print() const
+    {
+        for (size_t i = 0; i < hashTable.size(); i++)
+        {
+            cout << "Index " << i << ": ";
+            printChain(hashTable.find(i));
+        }
+        if (resizing())
+        {
+            cout << "Still in the old table (" << oldTable.size() << " buckets):\n";
+            for (size_t i = moved; i < oldTable.size(); i++)
+            {
+                cout << "Old index " << i << ": ";
+                printChain(oldTable.find(i));
+            }
+        }
+    }
+};
+
+// Insert n keys and report insert latencies (p50 / p99 / p999 / max)
+void measureLatency(bool incremental, int n)
+{
+    ChainedHashTable table(10, incremental);
+    mt19937 rng(7);
+    vector<double> ns(n);
+    for (int i = 0; i < n; i++)
+    {
+        int x = (int)rng();
+        auto start = chrono::steady_clock::now();
+        table.insert(x);
+        ns[i] = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    }
+    double total = accumulate(ns.begin(), ns.end(), 0.0);
+    sort(ns.begin(), ns.end());
+    cout << (incremental ? "incremental     " : "stop-the-world  ") << fixed << setprecision(0)
+         << "avg " << total / n << " ns, p50 " << ns[n / 2] << " ns, p99 " << ns[n * 99LL / 100]
+         << " ns, p999 " << ns[n * 999LL / 1000] << " ns, max " << ns[n - 1] / 1000 << " us\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && string(argv[1]) == "--latency")
+    {
+        int n = 2000000;
+        cout << n << " inserts, table starts at 10 buckets and doubles at load factor 1\n";
+        measureLatency(false, n);
+        measureLatency(true, n);
+        return 0;
+    }
+
+    vector<int> arr = {28, 38, 48, 18, 8, 22, 32, 42, 52, 62};
+    ChainedHashTable table(10);
+
+    // Insert elements using division method
+    for (int x : arr)
+    {
+        table.insert(x);
+    }
+
+    // Print hash table
+    table.print();
+
+    // Search for element 18
+    int key = 18;
+    if (table.search(key))
+    {
+        cout << "Found: " << key << endl;
+    }
+
+    // One more key pushes the load factor over 1 → the table starts growing to
+    // 20 buckets; the next inserts finish moving the old buckets
+    table.insert(72);
+    table.print();
+    cout << "Search 18 during resize: " << (table.search(key) ? "Found" : "Not found") << endl;
+    for (int x : {82, 92, 3, 13, 23})
+    {
+        table.insert(x);
+    }
+    table.print();
+    cout << "Size " << table.size() << ", buckets " << table.tableSize() << endl;
+
     return 0;
 }
 
@@ -73,11 +295,29 @@ Search only at:
 value % tableSize
 
 
+👉 Incremental Resizing
+
+Fixed tableSize → chains grow without limit.
+Grow (double) when size > tableSize, but do NOT rehash everything at once:
+
+- keep oldTable + new hashTable
+- every insert moves 2 old buckets into the new table
+- search checks the new table, then the old one (if that bucket is not moved yet)
+- buckets are allocated in segments of 256 on first use, so creating or
+  freeing a big table is also spread out
+
+Stop-the-world rehash → one insert pays O(n): a max latency spike
+                        (only ~log n inserts resize, so p50 / p999 barely see it)
+Incremental           → every insert during a resize pays O(1) extra
+                        (max latency stays small, p50 / p999 get a little worse)
+
+
 👉 Time & Space Complexity
 
 Insertion
 Average: O(1)
 Worst (all collide): O(n)
+Resize work: O(1) per insert (2 buckets), never O(n) in one insert
 
 Search
 Average: O(1)
@@ -140,5 +380,19 @@ Search only in hashTable[8]:
 
 18 found → print "Found: 18"
 
+Incremental resize:
+
+insert 72 → size 11 > 10 → new table with 20 buckets, old table kept
+           → 72 % 10 = 2 was already placed in old bucket 2 before the resize started
+
+search 18 during resize:
+new table: 18 % 20 = 18 → bucket empty (not moved yet)
+old table: 18 % 10 = 8  → {28, 38, 48, 18, 8} → Found
+
+insert 82, 92, 3, 13, 23 → each also moves 2 old buckets:
+old bucket 2 → 22 % 20 = 2, 32 % 20 = 12, 42 → 2, 52 → 12, 62 → 2, 72 → 12
+old bucket 8 → 28 → 8, 38 → 18, 48 → 8, 18 → 18, 8 → 8
+after 5 inserts all 10 old buckets are moved → old table freed
+
 ===============================================
 */
@@ -1,20 +1,20 @@
 #include <bits/stdc++.h>
+#include "byte-histogram.h"
+#include "frequency-counter.h"
+#include "streaming-sketches.h"
+#include "membership-index.h"
 using namespace std;
 
 /* ================================
    QUESTION 1: Frequency Query
    ================================ */
 
-// Time Complexity: O(n) for building, O(1) per query
-// Space Complexity: O(n) for frequency map
+// Time Complexity: O(n) for building (split across threads), O(1) per query
+// Space Complexity: O(n) for frequency table
 int frequencyQuery(const vector<int> &arr, int q)
 {
-    unordered_map<int, int> freq;
-    for (int x : arr)
-    {
-        freq[x]++;
-    }
-    return freq[q];
+    FrequencyCounts freq = countFrequencies(arr);
+    return (int)freq.count(q);
 }
 
 /* ================================
@@ -49,27 +49,39 @@ bool checkElementPresence(const vector<int> &arr, int target)
     return s.find(target) != s.end();
 }
 
+// Many queries on the same array: build the index ONCE (see membership-index.h)
+// Time Complexity: O(n log n) to build, O(1) per miss (one cache line), O(log n) per hit
+// Space Complexity: O(n) - sorted copy + 2 bytes of filter per element
+bool checkElementPresence(const MembershipIndex &index, int target)
+{
+    return index.contains(target);
+}
+
+// Batch version: results[i] = whether targets[i] is present
+vector<char> checkElementPresence(const MembershipIndex &index, const vector<int> &targets)
+{
+    return index.containsBatch(targets);
+}
+
 /* ================================
    QUESTION 4: Character Frequency (Lowercase)
    ================================ */
 
 // Time Complexity: O(n)
-// Space Complexity: O(1) - fixed 26 size array
-void frequencyOfLowercase(const string &s)
+// Space Complexity: O(1) - fixed 256 size array (byteHistogram)
+void frequencyOfLowercase(string_view s)
 {
-    int hash[26] = {0};
-
-    for (char c : s)
-    {
-        hash[c - 'a']++;
-    }
+    uint64_t hash[256];
+    byteHistogram(s, hash);
 
+    // Second pass prints in order of first appearance
     for (char c : s)
     {
-        if (hash[c - 'a'] > 0)
+        unsigned char b = c;
+        if (hash[b] > 0)
         {
-            cout << c << " -> " << hash[c - 'a'] << endl;
-            hash[c - 'a'] = 0;
+            cout << c << " -> " << hash[b] << endl;
+            hash[b] = 0;
         }
     }
 }
@@ -79,23 +91,20 @@ void frequencyOfLowercase(const string &s)
    ================================ */
 
 // Time Complexity: O(n)
-// Space Complexity: O(1) - fixed array
-void frequencyOfVowels(const string &s)
+// Space Complexity: O(1) - fixed 256 size array (byteHistogram)
+void frequencyOfVowels(string_view s)
 {
-    int hash[26] = {0};
-
-    for (char c : s)
-    {
-        hash[c - 'a']++;
-    }
+    uint64_t hash[256];
+    byteHistogram(s, hash);
 
     for (char c : s)
     {
+        unsigned char b = c;
         if ((c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u') &&
-            hash[c - 'a'] > 0)
+            hash[b] > 0)
         {
-            cout << c << " -> " << hash[c - 'a'] << endl;
-            hash[c - 'a'] = 0;
+            cout << c << " -> " << hash[b] << endl;
+            hash[b] = 0;
         }
     }
 }
@@ -239,6 +248,48 @@ void removeDuplicatesPreserveOrder(const vector<int> &arr)
     cout << endl;
 }
 
+/* ================================
+   QUESTION 11: Streaming Mode (Q1 / Q2 on Unbounded Streams)
+   ================================ */
+
+// Same answers as Q1 / Q2 / "most frequent", but with fixed memory:
+// the sketches never store the keys themselves (see streaming-sketches.h).
+// Time Complexity: O(1) per element (O(log k) for top-K)
+// Space Complexity: O(1) - fixed by the sketch size, whatever the stream length
+
+// Q2 streaming: HyperLogLog, error ≈ 1.04 / sqrt(2^precision)
+long long countDistinctStreaming(const vector<int> &stream, int precision = 14)
+{
+    HyperLogLog hll(precision);
+    for (int x : stream)
+    {
+        hll.add(x);
+    }
+    return llround(hll.estimate());
+}
+
+// Q1 streaming: Count-Min Sketch, never below the true frequency
+long long frequencyQueryStreaming(const vector<int> &stream, int q, size_t width = 2048, int depth = 5)
+{
+    CountMinSketch cms(width, depth);
+    for (int x : stream)
+    {
+        cms.add(x);
+    }
+    return (long long)cms.estimate(q);
+}
+
+// Most frequent k elements: Space-Saving (counts are upper bounds)
+vector<SpaceSaving::Entry> topKStreaming(const vector<int> &stream, size_t k)
+{
+    SpaceSaving summary(k);
+    for (int x : stream)
+    {
+        summary.add(x);
+    }
+    return summary.topK();
+}
+
 /* ================================
    MAIN FUNCTION - Test All Solutions
    ================================ */
@@ -272,7 +323,14 @@ int main()
     for (int x : arr3)
         cout << x << " ";
     cout << "\nTarget: " << target;
-    cout << "\nResult: " << (checkElementPresence(arr3, target) ? "Exists" : "Does not exist") << "\n\n";
+    cout << "\nResult: " << (checkElementPresence(arr3, target) ? "Exists" : "Does not exist") << "\n";
+    MembershipIndex index3(arr3); // prebuilt, reused for every query below
+    vector<int> targets3 = {10, 15, 30, 45};
+    vector<char> present3 = checkElementPresence(index3, targets3);
+    cout << "Batch with prebuilt index: ";
+    for (size_t i = 0; i < targets3.size(); i++)
+        cout << targets3[i] << (present3[i] ? " yes  " : " no  ");
+    cout << "\n\n";
 
     // Test Q4: Character Frequency
     cout << "Q4: Character Frequency (Lowercase)\n";
@@ -330,5 +388,28 @@ int main()
     cout << "\nWithout duplicates: ";
     removeDuplicatesPreserveOrder(arr10);
 
+    // Test Q11: Streaming Mode
+    cout << "\nQ11: Streaming Mode (1,000,000 numbers)\n";
+    mt19937 rng(42);
+    vector<int> stream(1000000);
+    for (int &x : stream)
+    {
+        // Half heavy hitters (1 most often, then 2, 3, ...), half random noise
+        x = rng() % 2 ? 1000 / (rng() % 1000 + 1) : rng() % 1000000;
+    }
+    cout << "Distinct: exact " << countDistinctElement(stream)
+         << ", HyperLogLog " << countDistinctStreaming(stream) << "\n";
+    cout << "Frequency of 5: exact " << frequencyQuery(stream, 5)
+         << ", Count-Min " << frequencyQueryStreaming(stream, 5) << "\n";
+    cout << "Top 3 (Space-Saving, k = 100): ";
+    vector<SpaceSaving::Entry> top = topKStreaming(stream, 100);
+    for (size_t i = 0; i < min<size_t>(3, top.size()); i++)
+    {
+        cout << top[i].key << " (~" << top[i].count << ") ";
+    }
+    StreamSketch merged = sketchInParallel(stream, 4, StreamSketch());
+    cout << "\n4 threads, merged sketches: distinct " << llround(merged.distinct.estimate())
+         << ", memory " << merged.memoryBytes() / 1024 << " KB\n";
+
     return 0;
 }
\ No newline at end of file
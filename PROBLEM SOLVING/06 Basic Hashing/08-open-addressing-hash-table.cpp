@@ -0,0 +1,467 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+/*
+👉 Problem Statement — Hash Table with Open Addressing (Robin Hood Probing)
+
+The chaining table (04-collision-and-linear-chaining.cpp) keeps a separate
+vector per bucket and uses value % tableSize, so keys like 8, 18, 28, ...
+all pile up in one bucket.
+
+Your task is to build a reusable hash table that:
+1) Stores every key in ONE flat array (open addressing, no per-bucket vectors).
+2) Mixes the bits of the key before picking a slot (no raw modulo).
+3) Resolves collisions with Robin Hood linear probing.
+4) Grows automatically when the load factor gets too high.
+5) Supports insert / find / erase, and beats std::unordered_map on int keys.
+
+Run with:  ./a.out               → demo on the chaining example
+           ./a.out --bench [n]   → benchmark against unordered_map (default n = 1000000)
+*/
+
+/* -------------------------------------------------- */
+/* 1️⃣ MIXING HASH */
+/* -------------------------------------------------- */
+
+// std::hash<int> is the identity, so similar keys would land in similar slots.
+// The murmur3 finalizer spreads every input bit over the whole 64-bit result.
+template <class K>
+struct MixHash
+{
+    size_t operator()(const K &key) const
+    {
+        uint64_t x = hash<K>()(key);
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+};
+
+/* -------------------------------------------------- */
+/* 2️⃣ ROBIN HOOD HASH TABLE */
+/* -------------------------------------------------- */
+
+// Open addressing with linear probing. Each slot remembers how far it is from
+// its home slot ("probe distance"). On insert, a key that has travelled further
+// takes the slot from a key that is closer to home ("rob the rich"), so every
+// probe sequence stays short. Erase shifts the following keys back one slot
+// instead of leaving tombstones.
+//
+// Capacity is a power of two (index = hash & mask), and the table doubles when
+// it is 7/8 full. K and V must be default-constructible.
+//
+// Hash must spread keys over the low bits: the index only uses hash & mask. A
+// probe run longer than MAX_DIST also forces a grow, but only while the table
+// is at least 1/4 full; below that, a long run means the hash itself collides
+// (e.g. k & 3), growing would not shorten it, so the insert just keeps probing
+// and every operation on that run degrades to O(run length).
+template <class K, class V, class Hash = MixHash<K>>
+class RobinHoodMap
+{
+    static constexpr uint32_t EMPTY = 0;      // dist[i] = probe distance + 1, 0 = empty
+    static constexpr uint32_t MAX_DIST = 250; // longer probe runs may force a grow
+
+    vector<uint32_t> dist;
+    vector<K> keys;
+    vector<V> vals;
+    size_t mask = 0;
+    size_t count = 0;
+    Hash hasher;
+
+    size_t home(const K &key) const
+    {
+        return hasher(key) & mask;
+    }
+
+    // Place a key known to be absent; returns its slot
+    size_t place(K key, V val)
+    {
+        if ((count + 1) * 8 > (mask + 1) * 7)
+        {
+            rehash((mask + 1) * 2);
+        }
+
+        K origKey = key;
+        size_t idx = home(key), result = SIZE_MAX;
+        uint32_t d = 1;
+        while (true)
+        {
+            if (dist[idx] == EMPTY)
+            {
+                dist[idx] = d;
+                keys[idx] = move(key);
+                vals[idx] = move(val);
+                count++;
+                return result == SIZE_MAX ? idx : result;
+            }
+            if (dist[idx] < d)
+            {
+                // The resident is closer to home: it gives up its slot
+                swap(d, dist[idx]);
+                swap(key, keys[idx]);
+                swap(val, vals[idx]);
+                if (result == SIZE_MAX)
+                {
+                    result = idx;
+                }
+            }
+            idx = (idx + 1) & mask;
+            if (++d > MAX_DIST && count * 4 > mask + 1)
+            {
+                // Long run in a well-filled table: grow and place the carried key again
+                rehash((mask + 1) * 2);
+                place(move(key), move(val));
+                return findSlot(origKey);
+            }
+        }
+    }
+
+    size_t findSlot(const K &key) const
+    {
+        size_t idx = home(key);
+        for (uint32_t d = 1;; d++)
+        {
+            // A key further than this slot's resident would have robbed it
+            if (dist[idx] < d)
+            {
+                return SIZE_MAX;
+            }
+            if (dist[idx] == d && keys[idx] == key)
+            {
+                return idx;
+            }
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    void rehash(size_t newCapacity)
+    {
+        vector<uint32_t> oldDist(newCapacity, EMPTY);
+        vector<K> oldKeys(newCapacity);
+        vector<V> oldVals(newCapacity);
+        oldDist.swap(dist);
+        oldKeys.swap(keys);
+        oldVals.swap(vals);
+        mask = newCapacity - 1;
+        count = 0;
+
+        for (size_t i = 0; i < oldDist.size(); i++)
+        {
+            if (oldDist[i] != EMPTY)
+            {
+                place(move(oldKeys[i]), move(oldVals[i]));
+            }
+        }
+    }
+
+public:
+    RobinHoodMap(size_t expected = 0)
+    {
+        dist.assign(8, EMPTY);
+        keys.resize(8);
+        vals.resize(8);
+        mask = 7;
+        reserve(expected);
+    }
+
+    // Make room for n keys without further growth
+    void reserve(size_t n)
+    {
+        size_t capacity = mask + 1;
+        while (n * 8 > capacity * 7)
+        {
+            capacity *= 2;
+        }
+        if (capacity != mask + 1)
+        {
+            rehash(capacity);
+        }
+    }
+
+    // Insert (key, val); returns false (and keeps the old value) if key exists
+    bool insert(const K &key, const V &val)
+    {
+        if (findSlot(key) != SIZE_MAX)
+        {
+            return false;
+        }
+        place(key, val);
+        return true;
+    }
+
+    // Value for key, inserting V() first if it is missing (like unordered_map)
+    V &operator[](const K &key)
+    {
+        size_t idx = findSlot(key);
+        if (idx == SIZE_MAX)
+        {
+            idx = place(key, V());
+        }
+        return vals[idx];
+    }
+
+    // Pointer to the value, or nullptr if key is absent
+    V *find(const K &key)
+    {
+        size_t idx = findSlot(key);
+        return idx == SIZE_MAX ? nullptr : &vals[idx];
+    }
+
+    bool contains(const K &key) const
+    {
+        return findSlot(key) != SIZE_MAX;
+    }
+
+    // Backward-shift deletion: no tombstones, probe runs stay short
+    bool erase(const K &key)
+    {
+        size_t idx = findSlot(key);
+        if (idx == SIZE_MAX)
+        {
+            return false;
+        }
+        size_t next = (idx + 1) & mask;
+        while (dist[next] > 1)
+        {
+            dist[idx] = dist[next] - 1;
+            keys[idx] = move(keys[next]);
+            vals[idx] = move(vals[next]);
+            idx = next;
+            next = (next + 1) & mask;
+        }
+        dist[idx] = EMPTY;
+        count--;
+        return true;
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return mask + 1; }
+
+    // Probe distance of slot i (-1 = empty), for printing the layout
+    int probeDistance(size_t i) const { return dist[i] == EMPTY ? -1 : dist[i] - 1; }
+    const K &keyAt(size_t i) const { return keys[i]; }
+    const V &valueAt(size_t i) const { return vals[i]; }
+};
+
+/* -------------------------------------------------- */
+/* 3️⃣ BENCHMARK vs std::unordered_map */
+/* -------------------------------------------------- */
+
+template <class Fn>
+double nsPerOp(size_t ops, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / ops;
+}
+
+void runBenchmark(size_t n)
+{
+    // Random int keys, plus a second set of keys that are not in the table
+    mt19937 rng(12345);
+    vector<int> present(n), absent(n);
+    unordered_set<int> used;
+    for (size_t i = 0; i < n; i++)
+    {
+        int x;
+        do
+        {
+            x = (int)rng();
+        } while (!used.insert(x).second);
+        present[i] = x;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        int x;
+        do
+        {
+            x = (int)rng();
+        } while (used.count(x));
+        absent[i] = x;
+    }
+    vector<int> lookupOrder = present;
+    shuffle(lookupOrder.begin(), lookupOrder.end(), rng);
+
+    long long checksum = 0;
+    double ours[4], std_[4];
+
+    {
+        RobinHoodMap<int, int> table;
+        ours[0] = nsPerOp(n, [&] { for (size_t i = 0; i < n; i++) table[present[i]] = (int)i; });
+        ours[1] = nsPerOp(n, [&] { for (int x : lookupOrder) checksum += *table.find(x); });
+        ours[2] = nsPerOp(n, [&] { for (int x : absent) checksum += table.find(x) != nullptr; });
+        ours[3] = nsPerOp(n, [&] { for (int x : lookupOrder) checksum += table.erase(x); });
+    }
+    {
+        unordered_map<int, int> table;
+        std_[0] = nsPerOp(n, [&] { for (size_t i = 0; i < n; i++) table[present[i]] = (int)i; });
+        std_[1] = nsPerOp(n, [&] { for (int x : lookupOrder) checksum += table.find(x)->second; });
+        std_[2] = nsPerOp(n, [&] { for (int x : absent) checksum += table.find(x) != table.end(); });
+        std_[3] = nsPerOp(n, [&] { for (int x : lookupOrder) checksum += table.erase(x); });
+    }
+
+    const char *names[4] = {"insert", "find (hit)", "find (miss)", "erase"};
+    cout << "n = " << n << " random int keys (ns per operation)\n\n";
+    cout << left << setw(14) << "operation" << right << setw(14) << "RobinHoodMap"
+         << setw(16) << "unordered_map" << setw(10) << "speedup" << "\n";
+    cout << fixed << setprecision(1);
+    for (int i = 0; i < 4; i++)
+    {
+        cout << left << setw(14) << names[i] << right << setw(14) << ours[i]
+             << setw(16) << std_[i] << setw(9) << std_[i] / ours[i] << "x\n";
+    }
+    cout << "\n(checksum " << checksum << ")\n";
+}
+
+/* -------------------------------------------------- */
+/* 4️⃣ DEMO ON THE CHAINING EXAMPLE */
+/* -------------------------------------------------- */
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && string(argv[1]) == "--bench")
+    {
+        runBenchmark(argc >= 3 ? stoul(argv[2]) : 1000000);
+        return 0;
+    }
+
+    // Same keys that made five-element chains in the chaining demo
+    vector<int> arr = {28, 38, 48, 18, 8, 22, 32, 42, 52, 62};
+
+    RobinHoodMap<int, int> table;
+    for (int x : arr)
+    {
+        table[x]++; // value = frequency
+    }
+
+    // Print the flat table: slot, key, and how far the key is from its home slot
+    cout << "Capacity " << table.capacity() << ", size " << table.size() << "\n";
+    for (size_t i = 0; i < table.capacity(); i++)
+    {
+        cout << "Slot " << setw(2) << i << ": ";
+        if (table.probeDistance(i) < 0)
+        {
+            cout << "-\n";
+        }
+        else
+        {
+            cout << table.keyAt(i) << " (probe distance " << table.probeDistance(i) << ")\n";
+        }
+    }
+
+    // Search for element 18
+    int key = 18;
+    cout << (table.contains(key) ? "Found: " : "Not found: ") << key << endl;
+
+    // Erase it and search again
+    table.erase(key);
+    cout << (table.contains(key) ? "Found: " : "Not found: ") << key << " (after erase)" << endl;
+
+    return 0;
+}
+
+/*
+==================== Key Concepts (Interview Focus) ====================
+
+
+👉 Open Addressing
+
+All keys live in ONE array. On a collision we step to the next slot
+(linear probing) instead of growing a per-bucket list.
+→ no heap node per key, neighbouring slots share cache lines.
+
+👉 Mixing Hash
+
+index = mix(key) & (capacity - 1)      capacity = power of two
+
+x % 10 only looks at the last digit, so 8, 18, 28, ... collide.
+A mixing hash (multiply + xor-shift) makes every bit of the key matter.
+
+👉 Robin Hood Probing
+
+Each slot stores its probe distance (how far it is from its home slot).
+While inserting, if the resident is CLOSER to home than the key we carry,
+swap them and keep going with the resident.
+→ probe distances stay small and even.
+→ a lookup can stop early: once a slot's distance is smaller than ours,
+  the key cannot be further on.
+
+👉 Erase (Backward Shift)
+
+Remove the key, then move each following key back by one slot
+(until an empty slot or a key already at home).
+→ no tombstones, so lookups never slow down after many erases.
+
+👉 Load Factor & Growth
+
+Grow (double + reinsert) when size > 7/8 of capacity.
+Robin Hood keeps probes short even at high load.
+
+
+👉 Time & Space Complexity
+
+Insert / Find / Erase
+Average: O(1)
+Worst: O(n) (every key in one probe run; the mixing hash makes this unlikely,
+       and a colliding hash only lengthens the run, it never grows the table
+       past 8x the key count)
+
+Growth
+O(n) per doubling, O(1) amortized per insert
+
+Space
+O(capacity) = O(n), one uint32_t of metadata per slot, no per-key nodes
+
+
+👉 Interview One-Liner
+
+Robin Hood hashing is open addressing where keys far from home steal slots
+from keys near home, keeping every probe sequence short.
+
+*/
+
+/*
+==================== DRY RUN ====================
+
+Given:
+arr = {28, 38, 48, 18, 8, 22, 32, 42, 52, 62}
+
+10 keys > 7/8 of 8 slots → table grows to 16 slots.
+
+Each key goes to slot mix(key) & 15 instead of key % 10, so the keys that
+shared bucket 8 (28, 38, 48, 18, 8) and bucket 2 (22, 32, ...) spread out:
+
+Slot  1: 52 (probe distance 0)
+Slot  2: 28 (probe distance 0)
+Slot  3: 48 (probe distance 0)
+Slot  4: 18 (probe distance 0)
+Slot  7: 22 (probe distance 0)
+Slot  8: 8  (probe distance 1)
+Slot  9: 62 (probe distance 2)
+Slot 12: 42 (probe distance 0)
+Slot 13: 32 (probe distance 0)
+Slot 14: 38 (probe distance 0)
+
+22, 8 and 62 all have home slot 7 → they form one probe run 7, 8, 9.
+
+Search 18:
+home slot 4 → 18 (distance 0) → Found: 18
+
+Search a missing key with home slot 8:
+slot 8: resident 8 has distance 1 ≥ ours (0), not our key → continue
+slot 9: resident 62 has distance 2 ≥ ours (1), not our key → continue
+slot 10: empty (distance < ours) → stop, Not found
+
+Erase 22 (slot 7), backward shift:
+slot 8: 8 has distance 1 > 0 → move to slot 7 (distance 0)
+slot 9: 62 has distance 2 > 0 → move to slot 8 (distance 1)
+slot 10: empty → stop, slot 9 becomes empty
+
+Erase 18, search again → Not found: 18
+
+===============================================
+*/
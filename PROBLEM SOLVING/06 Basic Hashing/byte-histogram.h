@@ -0,0 +1,163 @@
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BYTE_HISTOGRAM_AVX2 1
+#endif
+
+/*
+👉 Shared Byte Histogram Kernel
+
+Used by 03-character-hashing.cpp and 07-basic-hashing-practice-solutions.cpp.
+
+byteHistogram(s, counts) → counts[b] = how many times byte b occurs in s
+
+Why not just hash[c]++ ?
+- In "aaaa..." every increment has to wait for the previous one to be stored
+  (store-to-load dependency). Consecutive bytes here go to DIFFERENT
+  sub-tables, which are added together at the end.
+- If the CPU has AVX2 (checked at runtime), histogramRunSkipping uses one
+  vector compare per 32 bytes to spot a block that is one repeated byte
+  (padding, runs of spaces), which is counted with one add. Every other block
+  is counted byte by byte exactly like the scalar path. There is no vectorised
+  counting kernel here: AVX2 is only used for the run check.
+- Inputs of many MB are split across threads, one histogram per thread.
+*/
+
+// Sub-counters are 32-bit; flush them into the 64-bit totals every CHUNK bytes
+const size_t HISTOGRAM_CHUNK = size_t(1) << 30;
+
+// Below this size, starting threads costs more than it saves
+const size_t HISTOGRAM_PARALLEL_MIN = size_t(8) << 20;
+
+// Spread the 8 bytes of w over sub-tables t[0..3], two bytes per table
+inline void histogramWord(uint32_t (*t)[256], uint64_t w)
+{
+    t[0][w & 0xFF]++;
+    t[1][(w >> 8) & 0xFF]++;
+    t[2][(w >> 16) & 0xFF]++;
+    t[3][(w >> 24) & 0xFF]++;
+    t[0][(w >> 32) & 0xFF]++;
+    t[1][(w >> 40) & 0xFF]++;
+    t[2][(w >> 48) & 0xFF]++;
+    t[3][w >> 56]++;
+}
+
+// Portable path: 4 interleaved sub-tables, 8 bytes per step
+inline void histogramScalar(const unsigned char *p, size_t n, uint64_t counts[256])
+{
+    while (n > 0)
+    {
+        size_t chunk = std::min(n, HISTOGRAM_CHUNK), i = 0;
+        uint32_t sub[4][256] = {};
+        for (; i + 8 <= chunk; i += 8)
+        {
+            uint64_t w;
+            memcpy(&w, p + i, 8);
+            histogramWord(sub, w);
+        }
+        for (; i < chunk; i++)
+        {
+            sub[0][p[i]]++;
+        }
+        for (int b = 0; b < 256; b++)
+        {
+            counts[b] += (uint64_t)sub[0][b] + sub[1][b] + sub[2][b] + sub[3][b];
+        }
+        p += chunk;
+        n -= chunk;
+    }
+}
+
+#ifdef BYTE_HISTOGRAM_AVX2
+// Run-skipping path: AVX2 only checks whether a 32-byte block is one repeated
+// byte (then one add counts it); mixed blocks go through histogramWord over
+// 8 sub-tables, the same scalar counting as histogramScalar
+__attribute__((target("avx2"))) inline void histogramRunSkipping(const unsigned char *p, size_t n, uint64_t counts[256])
+{
+    while (n > 0)
+    {
+        size_t chunk = std::min(n, HISTOGRAM_CHUNK), i = 0;
+        uint32_t sub[8][256] = {};
+        for (; i + 32 <= chunk; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256((const __m256i *)(p + i));
+            __m256i first = _mm256_set1_epi8((char)p[i]);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, first)) == -1)
+            {
+                sub[0][p[i]] += 32;
+                continue;
+            }
+            uint64_t w[4];
+            memcpy(w, p + i, 32);
+            histogramWord(sub, w[0]); // alternate between two groups of 4 tables
+            histogramWord(sub + 4, w[1]);
+            histogramWord(sub, w[2]);
+            histogramWord(sub + 4, w[3]);
+        }
+        for (; i < chunk; i++)
+        {
+            sub[0][p[i]]++;
+        }
+        for (int b = 0; b < 256; b++)
+        {
+            uint64_t total = 0;
+            for (int t = 0; t < 8; t++)
+            {
+                total += sub[t][b];
+            }
+            counts[b] += total;
+        }
+        p += chunk;
+        n -= chunk;
+    }
+}
+#endif
+
+// Add the histogram of [p, p + n) into counts, skipping runs when AVX2 is available
+inline void histogramBlock(const unsigned char *p, size_t n, uint64_t counts[256])
+{
+#ifdef BYTE_HISTOGRAM_AVX2
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if (hasAVX2)
+    {
+        histogramRunSkipping(p, n, counts);
+        return;
+    }
+#endif
+    histogramScalar(p, n, counts);
+}
+
+// counts[b] = number of occurrences of byte b in s (counts is overwritten)
+inline void byteHistogram(std::string_view s, uint64_t counts[256])
+{
+    std::fill(counts, counts + 256, 0);
+    const unsigned char *p = (const unsigned char *)s.data();
+    size_t n = s.size();
+
+    size_t threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), n / HISTOGRAM_PARALLEL_MIN);
+    if (threads <= 1)
+    {
+        histogramBlock(p, n, counts);
+        return;
+    }
+
+    // One private histogram per thread, summed at the end
+    std::vector<std::array<uint64_t, 256>> partial(threads);
+    std::vector<std::thread> pool;
+    size_t per = n / threads;
+    for (size_t t = 0; t < threads; t++)
+    {
+        size_t begin = t * per, len = (t + 1 == threads) ? n - begin : per;
+        partial[t].fill(0);
+        pool.emplace_back(histogramBlock, p + begin, len, partial[t].data());
+    }
+    for (size_t t = 0; t < threads; t++)
+    {
+        pool[t].join();
+        for (int b = 0; b < 256; b++)
+        {
+            counts[b] += partial[t][b];
+        }
+    }
+}
@@ -0,0 +1,305 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+👉 Parallel Frequency Counter for Large Integer Arrays
+
+Used by 02-number-hashing-for-larger-input.cpp and
+07-basic-hashing-practice-solutions.cpp.
+
+countFrequencies(arr) → FrequencyCounts: count(key), distinct(), forEach(key, count)
+
+Two strategies, picked automatically:
+
+1) Small value range (max - min fits a table) → direct address table,
+   exactly like hash[x]++ in 02-number-hashing-array-based.cpp, with
+   index = x - min. Each thread counts its slice into its own array, then
+   the arrays are summed.
+
+2) Otherwise → radix-partitioned hashing:
+   Phase 1: each thread counts its slice into P small flat hash tables,
+            partition = top bits of hash(x) (no sharing, no locks).
+   Phase 2: partition p of every thread is merged by ONE thread into the
+            final table p. Partitions are independent, so this is parallel too.
+   A lookup later goes straight to partition hash(x) >> shift.
+*/
+
+// Flat open-addressing table specialised for counting: count 0 = empty slot
+class CountTable
+{
+    std::vector<int> keys;
+    std::vector<uint64_t> counts;
+    size_t mask = 0, used = 0;
+
+    void grow()
+    {
+        std::vector<int> oldKeys(keys.size() * 2);
+        std::vector<uint64_t> oldCounts(counts.size() * 2, 0);
+        oldKeys.swap(keys);
+        oldCounts.swap(counts);
+        mask = keys.size() - 1;
+        used = 0;
+        for (size_t i = 0; i < oldKeys.size(); i++)
+        {
+            if (oldCounts[i])
+            {
+                add(oldKeys[i], hashKey(oldKeys[i]), oldCounts[i]);
+            }
+        }
+    }
+
+public:
+    // murmur3 finalizer: low bits pick the slot, high bits pick the partition
+    static uint64_t hashKey(int key)
+    {
+        uint64_t x = (uint32_t)key;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    CountTable(size_t capacity = 16)
+    {
+        size_t cap = 16;
+        while (cap < capacity)
+        {
+            cap *= 2;
+        }
+        keys.assign(cap, 0);
+        counts.assign(cap, 0);
+        mask = cap - 1;
+    }
+
+    // counts[key] += c (h = hashKey(key))
+    void add(int key, uint64_t h, uint64_t c = 1)
+    {
+        size_t idx = h & mask;
+        while (counts[idx] && keys[idx] != key)
+        {
+            idx = (idx + 1) & mask;
+        }
+        if (!counts[idx])
+        {
+            keys[idx] = key;
+            if (++used * 4 > keys.size() * 3)
+            {
+                counts[idx] = c;
+                grow();
+                return;
+            }
+        }
+        counts[idx] += c;
+    }
+
+    uint64_t get(int key, uint64_t h) const
+    {
+        size_t idx = h & mask;
+        while (counts[idx])
+        {
+            if (keys[idx] == key)
+            {
+                return counts[idx];
+            }
+            idx = (idx + 1) & mask;
+        }
+        return 0;
+    }
+
+    size_t size() const { return used; }
+
+    template <class F>
+    void forEach(F f) const
+    {
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            if (counts[i])
+            {
+                f(keys[i], counts[i]);
+            }
+        }
+    }
+};
+
+// Result of countFrequencies: either a direct address table or P hash partitions
+class FrequencyCounts
+{
+public:
+    long long base = 0;               // direct: direct[i] = count of (base + i)
+    std::vector<uint64_t> direct;
+    int partitionBits = 0;            // hashed: partition = hash >> (64 - partitionBits)
+    std::vector<CountTable> partitions;
+
+    uint64_t count(int key) const
+    {
+        if (partitions.empty())
+        {
+            long long i = (long long)key - base;
+            return (i >= 0 && i < (long long)direct.size()) ? direct[i] : 0;
+        }
+        uint64_t h = CountTable::hashKey(key);
+        size_t p = partitionBits ? h >> (64 - partitionBits) : 0;
+        return partitions[p].get(key, h);
+    }
+
+    size_t distinct() const
+    {
+        size_t total = 0;
+        if (partitions.empty())
+        {
+            for (uint64_t c : direct)
+            {
+                total += c != 0;
+            }
+        }
+        for (const CountTable &t : partitions)
+        {
+            total += t.size();
+        }
+        return total;
+    }
+
+    // f(key, count) for every key that appears (order is not specified)
+    template <class F>
+    void forEach(F f) const
+    {
+        for (size_t i = 0; i < direct.size(); i++)
+        {
+            if (direct[i])
+            {
+                f((int)(base + (long long)i), direct[i]);
+            }
+        }
+        for (const CountTable &t : partitions)
+        {
+            t.forEach(f);
+        }
+    }
+};
+
+// Below this many elements one thread is faster than starting more
+const size_t FREQUENCY_PARALLEL_MIN = size_t(1) << 16;
+
+// Largest value range counted with a direct address table (8 MB per thread);
+// the range must also be dense enough (at most max(n, DENSE_MIN) slots)
+const size_t FREQUENCY_DIRECT_MAX = size_t(1) << 20;
+const size_t FREQUENCY_DENSE_MIN = size_t(1) << 12;
+
+// Run fn(t) for t in [0, threads) on separate threads (inline when threads == 1)
+template <class Fn>
+void runOnThreads(unsigned threads, Fn fn)
+{
+    if (threads == 1)
+    {
+        fn(0u);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool.emplace_back(fn, t);
+    }
+    for (std::thread &th : pool)
+    {
+        th.join();
+    }
+}
+
+inline FrequencyCounts countFrequencies(const std::vector<int> &arr, unsigned threads = 0)
+{
+    size_t n = arr.size();
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = (unsigned)std::max<size_t>(1, std::min<size_t>(threads, n / FREQUENCY_PARALLEL_MIN));
+    auto sliceBegin = [&](unsigned t) { return n * t / threads; };
+
+    FrequencyCounts result;
+    if (n == 0)
+    {
+        return result;
+    }
+
+    // Value range (per thread, then combined) decides the strategy
+    std::vector<int> lo(threads), hi(threads);
+    runOnThreads(threads, [&](unsigned t) {
+        auto range = std::minmax_element(arr.begin() + sliceBegin(t), arr.begin() + sliceBegin(t + 1));
+        lo[t] = *range.first;
+        hi[t] = *range.second;
+    });
+    long long minValue = *std::min_element(lo.begin(), lo.end());
+    long long maxValue = *std::max_element(hi.begin(), hi.end());
+    size_t range = (size_t)(maxValue - minValue + 1);
+
+    if (range <= FREQUENCY_DIRECT_MAX && range <= std::max(n, FREQUENCY_DENSE_MIN))
+    {
+        // 1) Direct address table: index = value - min
+        std::vector<std::vector<uint64_t>> local(threads);
+        runOnThreads(threads, [&](unsigned t) {
+            std::vector<uint64_t> &hash = t == 0 ? result.direct : local[t];
+            hash.assign(range, 0);
+            for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); i++)
+            {
+                hash[arr[i] - minValue]++;
+            }
+        });
+        result.base = minValue;
+        // Sum the per-thread tables, each thread owning a slice of the indexes
+        runOnThreads(threads, [&](unsigned t) {
+            for (size_t i = range * t / threads; i < range * (t + 1) / threads; i++)
+            {
+                for (unsigned s = 1; s < threads; s++)
+                {
+                    result.direct[i] += local[s][i];
+                }
+            }
+        });
+        return result;
+    }
+
+    // 2) Radix-partitioned hashing: P = 4 partitions per thread (power of two)
+    int bits = 0;
+    while ((1u << bits) < threads * 4)
+    {
+        bits++;
+    }
+    size_t partitions = size_t(1) << bits;
+    auto partitionOf = [&](uint64_t h) { return bits ? (size_t)(h >> (64 - bits)) : 0; };
+
+    // Phase 1: thread-local tables, one per partition
+    std::vector<std::vector<CountTable>> local(threads);
+    runOnThreads(threads, [&](unsigned t) {
+        local[t].resize(partitions);
+        for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); i++)
+        {
+            uint64_t h = CountTable::hashKey(arr[i]);
+            local[t][partitionOf(h)].add(arr[i], h);
+        }
+    });
+
+    // Phase 2: partitions are claimed one at a time and merged by a single thread
+    result.partitionBits = bits;
+    result.partitions.resize(partitions);
+    std::atomic<size_t> nextPartition(0);
+    runOnThreads(threads, [&](unsigned) {
+        for (size_t p; (p = nextPartition.fetch_add(1)) < partitions;)
+        {
+            size_t expected = 0;
+            for (unsigned s = 0; s < threads; s++)
+            {
+                expected += local[s][p].size();
+            }
+            CountTable merged(expected * 4 / 3 + 1);
+            for (unsigned s = 0; s < threads; s++)
+            {
+                local[s][p].forEach([&](int key, uint64_t c) { merged.add(key, CountTable::hashKey(key), c); });
+                local[s][p] = CountTable(); // free as we go
+            }
+            result.partitions[p] = std::move(merged);
+        }
+    });
+    return result;
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MEMBERSHIP_AVX2 1
+#endif
+
+/*
+👉 Membership Index (Blocked Bloom Filter + Exact Set)
+
+Used by Q3 (Check Element Presence) in 07-basic-hashing-practice-solutions.cpp.
+
+checkElementPresence rebuilds an unordered_set on every call. MembershipIndex
+is built ONCE and then answers any number of queries:
+
+Tier 1: blocked Bloom filter
+        - every key sets 8 bits inside ONE 32-byte block (within one cache line)
+        - "not in filter" → definitely absent, answered from that one line
+        - "maybe in filter" → go to tier 2
+Tier 2: exact set (sorted array + binary search)
+        - only reached by real members and ~0.13% false positives
+
+Most queries are misses, so almost every query stops at tier 1.
+With AVX2 (picked at runtime) the 8 bit tests are one multiply, one shift
+and one vptest. containsBatch() hashes a group of keys first and prefetches
+their blocks, so the cache misses of a whole group overlap instead of queueing.
+*/
+
+class MembershipIndex
+{
+    // 256 bits, 32-byte aligned (never straddles a cache line);
+    // a key sets one bit in each of the 8 words
+    struct alignas(32) Block
+    {
+        uint32_t words[8];
+    };
+
+    std::vector<Block> blocks;
+    std::vector<int> members; // sorted, unique: the exact tier
+
+    static uint64_t hashKey(int key)
+    {
+        uint64_t x = (uint32_t)key;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // Bit (0..31) of word i = top 5 bits of (low 32 hash bits × odd salt i)
+    static constexpr uint32_t SALTS[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                          0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    // High 32 bits pick the block (multiply-shift instead of %)
+    size_t blockOf(uint64_t h) const
+    {
+        return (size_t)(((h >> 32) * blocks.size()) >> 32);
+    }
+
+    bool mayContainScalar(uint64_t h) const
+    {
+        const Block &b = blocks[blockOf(h)];
+        uint32_t key = (uint32_t)h, missing = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            missing |= ~b.words[i] & (1u << ((key * SALTS[i]) >> 27));
+        }
+        return missing == 0;
+    }
+
+#ifdef MEMBERSHIP_AVX2
+    // Same test, all 8 words at once: multiply, shift, and "are all bits set?"
+    __attribute__((target("avx2"))) bool mayContainAVX2(uint64_t h) const
+    {
+        __m256i bits = _mm256_mullo_epi32(_mm256_set1_epi32((int)(uint32_t)h),
+                                          _mm256_loadu_si256((const __m256i *)SALTS));
+        __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), _mm256_srli_epi32(bits, 27));
+        __m256i block = _mm256_load_si256((const __m256i *)blocks[blockOf(h)].words);
+        return _mm256_testc_si256(block, mask); // (~block & mask) == 0
+    }
+
+    __attribute__((target("avx2"))) void containsBatchAVX2(const int *keys, size_t n, char *out) const
+    {
+        const size_t GROUP = 16;
+        uint64_t h[GROUP];
+        for (size_t base = 0; base < n; base += GROUP)
+        {
+            size_t m = std::min(GROUP, n - base);
+            for (size_t j = 0; j < m; j++)
+            {
+                h[j] = hashKey(keys[base + j]);
+                __builtin_prefetch(&blocks[blockOf(h[j])]);
+            }
+            for (size_t j = 0; j < m; j++)
+            {
+                out[base + j] = mayContainAVX2(h[j]) && exactContains(keys[base + j]);
+            }
+        }
+    }
+#endif
+
+    static bool hasAVX2()
+    {
+#ifdef MEMBERSHIP_AVX2
+        static const bool has = __builtin_cpu_supports("avx2");
+        return has;
+#else
+        return false;
+#endif
+    }
+
+    bool mayContain(uint64_t h) const
+    {
+#ifdef MEMBERSHIP_AVX2
+        if (hasAVX2())
+        {
+            return mayContainAVX2(h);
+        }
+#endif
+        return mayContainScalar(h);
+    }
+
+    bool exactContains(int key) const
+    {
+        return std::binary_search(members.begin(), members.end(), key);
+    }
+
+public:
+    // bitsPerKey = filter size per distinct key (16 → ~0.13% false positives)
+    MembershipIndex(const std::vector<int> &arr, int bitsPerKey = 16) : members(arr)
+    {
+        std::sort(members.begin(), members.end());
+        members.erase(std::unique(members.begin(), members.end()), members.end());
+
+        size_t bits = std::max<size_t>(members.size() * std::max(bitsPerKey, 1), 256);
+        blocks.assign((bits + 255) / 256, Block{});
+        for (int key : members)
+        {
+            uint64_t h = hashKey(key);
+            Block &b = blocks[blockOf(h)];
+            for (int i = 0; i < 8; i++)
+            {
+                b.words[i] |= 1u << (((uint32_t)h * SALTS[i]) >> 27);
+            }
+        }
+    }
+
+    bool contains(int key) const
+    {
+        return mayContain(hashKey(key)) && exactContains(key);
+    }
+
+    // out[i] = contains(keys[i]) for n keys; groups of 16 are hashed and their
+    // blocks prefetched before any of them is tested
+    void containsBatch(const int *keys, size_t n, char *out) const
+    {
+#ifdef MEMBERSHIP_AVX2
+        if (hasAVX2())
+        {
+            containsBatchAVX2(keys, n, out);
+            return;
+        }
+#endif
+        const size_t GROUP = 16;
+        uint64_t h[GROUP];
+        for (size_t base = 0; base < n; base += GROUP)
+        {
+            size_t m = std::min(GROUP, n - base);
+            for (size_t j = 0; j < m; j++)
+            {
+                h[j] = hashKey(keys[base + j]);
+                __builtin_prefetch(&blocks[blockOf(h[j])]);
+            }
+            for (size_t j = 0; j < m; j++)
+            {
+                out[base + j] = mayContainScalar(h[j]) && exactContains(keys[base + j]);
+            }
+        }
+    }
+
+    std::vector<char> containsBatch(const std::vector<int> &keys) const
+    {
+        std::vector<char> out(keys.size());
+        containsBatch(keys.data(), keys.size(), out.data());
+        return out;
+    }
+
+    size_t size() const { return members.size(); }
+    size_t filterBytes() const { return blocks.size() * sizeof(Block); }
+};
@@ -0,0 +1,380 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+👉 Streaming Sketches (fixed memory, approximate answers)
+
+Used by the streaming mode of 07-basic-hashing-practice-solutions.cpp.
+
+unordered_set / unordered_map keep EVERY distinct key, so on an endless
+stream they grow without limit. A sketch keeps a fixed-size summary instead:
+
+HyperLogLog     → how many DISTINCT keys?      2^p one-byte registers
+                  error ≈ 1.04 / sqrt(2^p)      (p = 14 → 16 KB, ≈ 0.8%)
+CountMinSketch  → how often did key x appear?  depth × width counters
+                  never under-counts; over-counts by ≤ e/width × total
+                  with probability 1 - e^-depth
+SpaceSaving     → which keys are the most frequent (top-K)?   k entries
+                  every key with frequency > total / k is guaranteed to be kept
+
+All three can be merged: build one per thread (or per server), merge at the end.
+*/
+
+// murmur3 finalizer: every sketch derives its positions from this one hash
+inline uint64_t sketchHash(int key)
+{
+    uint64_t x = (uint32_t)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/* -------------------------------------------------- */
+/* 1️⃣ HYPERLOGLOG — distinct count */
+/* -------------------------------------------------- */
+
+// The first p hash bits pick a register; the register keeps the longest run
+// of leading zeros seen in the remaining bits. Seeing a run of r zeros takes
+// about 2^r distinct keys, and averaging over 2^p registers tames the noise.
+class HyperLogLog
+{
+    int p;
+    std::vector<uint8_t> registers;
+
+public:
+    HyperLogLog(int precision = 14) : p(std::min(std::max(precision, 4), 18)), registers(size_t(1) << p, 0) {}
+
+    void add(int key)
+    {
+        uint64_t h = sketchHash(key);
+        size_t idx = h >> (64 - p);
+        // Guard bit keeps clz defined when the remaining bits are all zero
+        uint8_t rank = (uint8_t)(__builtin_clzll((h << p) | (uint64_t(1) << (p - 1))) + 1);
+        registers[idx] = std::max(registers[idx], rank);
+    }
+
+    double estimate() const
+    {
+        double m = (double)registers.size(), sum = 0;
+        size_t zeros = 0;
+        for (uint8_t r : registers)
+        {
+            sum += std::ldexp(1.0, -r);
+            zeros += r == 0;
+        }
+        double alpha = 0.7213 / (1 + 1.079 / m);
+        double e = alpha * m * m / sum;
+        // Small cardinalities: linear counting on the empty registers is more accurate
+        if (e <= 2.5 * m && zeros > 0)
+        {
+            e = m * std::log(m / zeros);
+        }
+        return e;
+    }
+
+    // Union of the two streams (same precision required)
+    void merge(const HyperLogLog &other)
+    {
+        if (other.p != p)
+        {
+            throw std::invalid_argument("HyperLogLog precision mismatch");
+        }
+        for (size_t i = 0; i < registers.size(); i++)
+        {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+    }
+
+    size_t memoryBytes() const { return registers.size(); }
+};
+
+/* -------------------------------------------------- */
+/* 2️⃣ COUNT-MIN SKETCH — frequency of one key */
+/* -------------------------------------------------- */
+
+// depth rows of width counters; each row adds the key to one counter.
+// Collisions only ever ADD, so the smallest of the depth counters is the
+// best estimate (and is never below the true count).
+class CountMinSketch
+{
+    size_t width;
+    int depth;
+    std::vector<uint64_t> counters; // depth rows of width
+    uint64_t total = 0;
+
+    // Row i uses h1 + i * h2 (two hashes are enough for all rows)
+    size_t column(uint64_t h, int row) const
+    {
+        uint64_t h1 = h & 0xFFFFFFFF, h2 = (h >> 32) | 1;
+        return (size_t)((h1 + row * h2) % width);
+    }
+
+public:
+    CountMinSketch(size_t width = 2048, int depth = 5)
+        : width(std::max<size_t>(width, 1)), depth(std::max(depth, 1)), counters(this->width * this->depth, 0) {}
+
+    // Sketch sized for: estimate ≤ true + epsilon × total, with probability 1 - delta
+    static CountMinSketch forError(double epsilon, double delta)
+    {
+        return CountMinSketch((size_t)std::ceil(std::exp(1.0) / epsilon), (int)std::ceil(std::log(1 / delta)));
+    }
+
+    void add(int key, uint64_t count = 1)
+    {
+        uint64_t h = sketchHash(key);
+        for (int row = 0; row < depth; row++)
+        {
+            counters[row * width + column(h, row)] += count;
+        }
+        total += count;
+    }
+
+    uint64_t estimate(int key) const
+    {
+        uint64_t h = sketchHash(key), best = UINT64_MAX;
+        for (int row = 0; row < depth; row++)
+        {
+            best = std::min(best, counters[row * width + column(h, row)]);
+        }
+        return best;
+    }
+
+    // Sum of the two streams (same width and depth required)
+    void merge(const CountMinSketch &other)
+    {
+        if (other.width != width || other.depth != depth)
+        {
+            throw std::invalid_argument("CountMinSketch shape mismatch");
+        }
+        for (size_t i = 0; i < counters.size(); i++)
+        {
+            counters[i] += other.counters[i];
+        }
+        total += other.total;
+    }
+
+    uint64_t totalCount() const { return total; }
+    size_t memoryBytes() const { return counters.size() * sizeof(uint64_t); }
+};
+
+/* -------------------------------------------------- */
+/* 3️⃣ SPACE-SAVING — top-K heavy hitters */
+/* -------------------------------------------------- */
+
+// Keeps at most k (key, count) entries. A new key, when all k are in use,
+// replaces the entry with the SMALLEST count and inherits that count (so
+// counts are upper bounds; 'error' is how much of it may be inherited).
+// A min-heap over the entries finds the smallest in O(1), updates cost O(log k).
+class SpaceSaving
+{
+public:
+    struct Entry
+    {
+        int key;
+        uint64_t count; // upper bound on the true frequency
+        uint64_t error; // count - error is a lower bound
+    };
+
+private:
+    size_t k;
+    std::vector<Entry> entries;
+    std::vector<size_t> heap, heapPos; // heap of entry indexes ordered by count
+    std::unordered_map<int, size_t> index;
+
+    bool less(size_t a, size_t b) const { return entries[heap[a]].count < entries[heap[b]].count; }
+
+    void swapNodes(size_t a, size_t b)
+    {
+        std::swap(heap[a], heap[b]);
+        heapPos[heap[a]] = a;
+        heapPos[heap[b]] = b;
+    }
+
+    // Counts only grow, so an entry only ever moves down the heap
+    void siftDown(size_t i)
+    {
+        while (true)
+        {
+            size_t smallest = i, l = 2 * i + 1, r = 2 * i + 2;
+            if (l < heap.size() && less(l, smallest))
+                smallest = l;
+            if (r < heap.size() && less(r, smallest))
+                smallest = r;
+            if (smallest == i)
+                return;
+            swapNodes(i, smallest);
+            i = smallest;
+        }
+    }
+
+    void siftUp(size_t i)
+    {
+        while (i > 0 && less(i, (i - 1) / 2))
+        {
+            swapNodes(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+public:
+    SpaceSaving(size_t k = 100) : k(std::max<size_t>(k, 1))
+    {
+        entries.reserve(this->k);
+        heap.reserve(this->k);
+        heapPos.reserve(this->k);
+        index.reserve(this->k * 2);
+    }
+
+    void add(int key, uint64_t count = 1, uint64_t error = 0)
+    {
+        auto it = index.find(key);
+        if (it != index.end())
+        {
+            entries[it->second].count += count;
+            entries[it->second].error += error;
+            siftDown(heapPos[it->second]);
+            return;
+        }
+        if (entries.size() < k)
+        {
+            index[key] = entries.size();
+            heapPos.push_back(heap.size());
+            heap.push_back(entries.size());
+            entries.push_back({key, count, error});
+            siftUp(heap.size() - 1);
+            return;
+        }
+        // Evict the smallest entry; the new key inherits its count as error
+        size_t victim = heap[0];
+        uint64_t floor = entries[victim].count;
+        index.erase(entries[victim].key);
+        index[key] = victim;
+        entries[victim] = {key, floor + count, floor + error};
+        siftDown(0);
+    }
+
+    // Smallest tracked count: any key not in the summary occurred at most this often
+    uint64_t minCount() const
+    {
+        return entries.size() < k ? 0 : entries[heap[0]].count;
+    }
+
+    // Combine two summaries: a key missing from one side may have occurred up
+    // to that side's minCount(), so that much is added as count and error
+    void merge(const SpaceSaving &other)
+    {
+        uint64_t mineMissing = minCount(), otherMissing = other.minCount();
+        std::unordered_map<int, Entry> combined;
+        for (const Entry &e : entries)
+        {
+            combined[e.key] = {e.key, e.count + otherMissing, e.error + otherMissing};
+        }
+        for (const Entry &e : other.entries)
+        {
+            auto it = combined.find(e.key);
+            if (it != combined.end())
+            {
+                it->second.count += e.count - otherMissing;
+                it->second.error += e.error - otherMissing;
+            }
+            else
+            {
+                combined[e.key] = {e.key, e.count + mineMissing, e.error + mineMissing};
+            }
+        }
+        std::vector<Entry> all;
+        for (auto &kv : combined)
+        {
+            all.push_back(kv.second);
+        }
+        size_t keep = std::min(k, all.size());
+        std::partial_sort(all.begin(), all.begin() + keep, all.end(),
+                          [](const Entry &a, const Entry &b) { return a.count > b.count; });
+
+        entries.clear();
+        heap.clear();
+        heapPos.clear();
+        index.clear();
+        for (size_t i = 0; i < keep; i++)
+        {
+            add(all[i].key, all[i].count, all[i].error);
+        }
+    }
+
+    // Tracked entries, most frequent first
+    std::vector<Entry> topK() const
+    {
+        std::vector<Entry> result = entries;
+        std::sort(result.begin(), result.end(), [](const Entry &a, const Entry &b) { return a.count > b.count; });
+        return result;
+    }
+
+    size_t memoryBytes() const
+    {
+        return k * (sizeof(Entry) + 2 * sizeof(size_t)) + index.bucket_count() * sizeof(void *) +
+               index.size() * (sizeof(std::pair<const int, size_t>) + sizeof(void *));
+    }
+};
+
+/* -------------------------------------------------- */
+/* 4️⃣ ALL THREE TOGETHER */
+/* -------------------------------------------------- */
+
+// One object per stream (or per thread); memory is fixed by the constructor
+struct StreamSketch
+{
+    HyperLogLog distinct;
+    CountMinSketch frequency;
+    SpaceSaving heavyHitters;
+
+    StreamSketch(int hllPrecision = 14, size_t cmsWidth = 2048, int cmsDepth = 5, size_t topK = 100)
+        : distinct(hllPrecision), frequency(cmsWidth, cmsDepth), heavyHitters(topK) {}
+
+    void add(int key)
+    {
+        distinct.add(key);
+        frequency.add(key);
+        heavyHitters.add(key);
+    }
+
+    void merge(const StreamSketch &other)
+    {
+        distinct.merge(other.distinct);
+        frequency.merge(other.frequency);
+        heavyHitters.merge(other.heavyHitters);
+    }
+
+    size_t memoryBytes() const
+    {
+        return distinct.memoryBytes() + frequency.memoryBytes() + heavyHitters.memoryBytes();
+    }
+};
+
+// Sketch arr on several threads, one StreamSketch each, merged at the end
+inline StreamSketch sketchInParallel(const std::vector<int> &arr, unsigned threads, const StreamSketch &shape)
+{
+    threads = std::max(1u, threads);
+    std::vector<StreamSketch> local(threads, shape);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&, t] {
+            for (size_t i = arr.size() * t / threads; i < arr.size() * (t + 1) / threads; i++)
+            {
+                local[t].add(arr[i]);
+            }
+        });
+    }
+    for (std::thread &th : pool)
+    {
+        th.join();
+    }
+    for (unsigned t = 1; t < threads; t++)
+    {
+        local[0].merge(local[t]);
+    }
+    return local[0];
+}
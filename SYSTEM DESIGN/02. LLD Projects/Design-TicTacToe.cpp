@@ -1,25 +1,50 @@
 // tic_tac_toe.cpp
 // Simple console-based Tic-Tac-Toe game using basic OOP.
-// 2 human players (X and O), 3x3 board, play via terminal input.
+// 2 players (X and O), human or computer, 3x3 board by default, play via terminal input.
+// Two board backends share one interface: Board (char grid) and
+// BitBoard (one bitset per player, k-in-a-row win masks).
 
 #include <iostream>
 #include <vector>
 #include <string>
+#include <bitset>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
 
 using namespace std;
 
+class AIPlayer;
+
 // ----------------------------------------------------------
-// Player class: represents a human player in the game
+// Player class: represents a player in the game
 // ----------------------------------------------------------
 class Player
 {
 private:
     string name; // name of the player (for display)
     char symbol; // 'X' or 'O'
+    AIPlayer *ai; // computer player's engine (nullptr = human at the terminal)
 
 public:
     // Constructor: set name and symbol at object creation
-    Player(const string &name, char symbol) : name(name), symbol(symbol) {}
+    Player(const string &name, char symbol, AIPlayer *ai = nullptr) : name(name), symbol(symbol), ai(ai) {}
+
+    // Getter for the engine (nullptr for a human)
+    AIPlayer *getAI() const
+    {
+        return ai;
+    }
 
     // Getter for name
     string getName() const
@@ -47,11 +72,54 @@ private:
     // Board size: here we keep it 3, but could be generalized
     int size;
 
+    // Incremental win tracking (two players, indexed 0 and 1):
+    // how many cells of each row / column / diagonal a player owns.
+    // A player wins when one of their counters reaches 'size',
+    // so the check after a move is O(1) instead of an O(n^2) rescan.
+    char symbols[2];          // symbol of player 0 / 1 (' ' = not seen yet)
+    vector<int> rowCounts;    // rowCounts[player * size + row]
+    vector<int> colCounts;    // colCounts[player * size + col]
+    int diagCounts[2];        // main diagonal, per player
+    int antiDiagCounts[2];    // anti-diagonal, per player
+    bool won[2];              // set by placeSymbol when a line completes
+    int moveCount;            // filled cells (board is full at size * size)
+
+    // Map a symbol to player 0 or 1 (first two symbols seen); -1 for a third symbol
+    int playerIndex(char symbol)
+    {
+        for (int p = 0; p < 2; ++p)
+        {
+            if (symbols[p] == ' ')
+            {
+                symbols[p] = symbol;
+            }
+            if (symbols[p] == symbol)
+            {
+                return p;
+            }
+        }
+        return -1;
+    }
+
+    // Same lookup without registering the symbol
+    int findPlayer(char symbol) const
+    {
+        for (int p = 0; p < 2; ++p)
+        {
+            if (symbols[p] == symbol)
+            {
+                return p;
+            }
+        }
+        return -1;
+    }
+
 public:
     // Constructor: initialize a size x size board with spaces
     Board(int n = 3) : size(n)
     {
         grid = vector<vector<char>>(size, vector<char>(size, ' '));
+        reset();
     }
 
     // Display the board in a user-friendly format
@@ -88,6 +156,23 @@ public:
         cout << "\n";
     }
 
+    // Board dimensions (Board only supports full-line wins)
+    int getSize() const
+    {
+        return size;
+    }
+
+    int getWinLength() const
+    {
+        return size;
+    }
+
+    // Symbol at (row, col), ' ' if empty
+    char getCell(int row, int col) const
+    {
+        return grid[row][col];
+    }
+
     // Check if given (row, col) indices are within the board bounds
     bool isValidPosition(int row, int col) const
     {
@@ -118,199 +203,1089 @@ public:
         {
             return false;
         }
+        // Only two players can share a board
+        int player = playerIndex(symbol);
+        if (player < 0)
+        {
+            return false;
+        }
         // If valid and empty, place the symbol
         grid[row][col] = symbol;
+        ++moveCount;
+
+        // Update this player's counters for every line through (row, col)
+        if (++rowCounts[player * size + row] == size)
+        {
+            won[player] = true;
+        }
+        if (++colCounts[player * size + col] == size)
+        {
+            won[player] = true;
+        }
+        if (row == col && ++diagCounts[player] == size)
+        {
+            won[player] = true;
+        }
+        if (row + col == size - 1 && ++antiDiagCounts[player] == size)
+        {
+            won[player] = true;
+        }
+        return true;
+    }
+
+    // Undo the move at (row, col): clear the cell and roll back its owner's counters
+    // Returns false if the cell is out of bounds or already empty
+    bool undo(int row, int col)
+    {
+        if (!isValidPosition(row, col) || isCellEmpty(row, col))
+        {
+            return false;
+        }
+        int player = findPlayer(grid[row][col]);
+        grid[row][col] = ' ';
+        --moveCount;
+        --rowCounts[player * size + row];
+        --colCounts[player * size + col];
+        if (row == col)
+        {
+            --diagCounts[player];
+        }
+        if (row + col == size - 1)
+        {
+            --antiDiagCounts[player];
+        }
+
+        // The undone cell can only break lines, so recheck whether any is still complete
+        bool stillWon = diagCounts[player] == size || antiDiagCounts[player] == size;
+        for (int i = 0; i < size && !stillWon; ++i)
+        {
+            stillWon = rowCounts[player * size + i] == size || colCounts[player * size + i] == size;
+        }
+        won[player] = stillWon;
         return true;
     }
 
     // Check if a given symbol has won the game
+    // O(1): placeSymbol already records when one of the player's lines is complete
     bool checkWin(char symbol) const
     {
-        // Check all rows
+        int player = findPlayer(symbol);
+        return player >= 0 && won[player];
+    }
+
+    // Check if the board is completely filled (used for detecting draw)
+    bool isFull() const
+    {
+        return moveCount == size * size;
+    }
+
+    // Reset board to empty state (also clears the win counters)
+    void reset()
+    {
         for (int i = 0; i < size; ++i)
         {
-            bool rowWin = true;
             for (int j = 0; j < size; ++j)
             {
-                if (grid[i][j] != symbol)
-                {
-                    rowWin = false;
-                    break;
-                }
-            }
-            if (rowWin)
-            {
-                return true;
+                grid[i][j] = ' ';
             }
         }
+        rowCounts.assign(2 * size, 0);
+        colCounts.assign(2 * size, 0);
+        for (int p = 0; p < 2; ++p)
+        {
+            symbols[p] = ' ';
+            diagCounts[p] = 0;
+            antiDiagCounts[p] = 0;
+            won[p] = false;
+        }
+        moveCount = 0;
+    }
+};
+
+// ----------------------------------------------------------
+// BitBoard class: same interface as Board, stored as bitsets
+// ----------------------------------------------------------
+// One bitset per player (bit index = row * size + col) instead of a
+// grid of rows, so the whole position is a few machine words.
+// Every k-in-a-row line is precomputed once per (size, k) as a mask;
+// a move wins if (playerCells & mask) == mask for a mask through it.
+// play()/unplay() work on cell indices and player numbers for search
+// and simulation code; placeSymbol()/undo() keep the Board interface.
+class BitBoard
+{
+public:
+    static constexpr int MAX_SIZE = 16;                  // largest supported board
+    static constexpr int MAX_CELLS = MAX_SIZE * MAX_SIZE;
+    typedef bitset<MAX_CELLS> Cells;
+
+    // Win lines for one (size, winLength), shared by all boards of that shape
+    struct WinMasks
+    {
+        vector<Cells> masks;   // every k-in-a-row line
+        vector<int> cellStart; // masks through cell c: cellMasks[cellStart[c] .. cellStart[c + 1])
+        vector<int> cellMasks; // indices into 'masks'
+        Cells allCells;        // bits of the size * size board
+    };
+
+private:
+
+    int size;      // board is size x size
+    int winLength; // k in a row wins
+    shared_ptr<const WinMasks> winMasks;
+    Cells cells[2];   // cells owned by player 0 / 1
+    char symbols[2];  // symbol of player 0 / 1 (' ' = not seen yet)
+    bool won[2];      // set when a move completes a line
+    int moveCount;    // filled cells
+
+    // Build (or reuse) the win masks for a board shape; thread-safe
+    static shared_ptr<const WinMasks> winMasksFor(int size, int winLength)
+    {
+        static mutex cacheMutex;
+        static map<pair<int, int>, shared_ptr<const WinMasks>> cache;
+        lock_guard<mutex> lock(cacheMutex);
+        shared_ptr<const WinMasks> &cached = cache[make_pair(size, winLength)];
+        if (cached)
+        {
+            return cached;
+        }
 
-        // Check all columns
-        for (int j = 0; j < size; ++j)
+        shared_ptr<WinMasks> built = make_shared<WinMasks>();
+        // Directions: right, down, down-right, down-left
+        const int dr[4] = {0, 1, 1, 1};
+        const int dc[4] = {1, 0, 1, -1};
+        vector<vector<int>> masksOfCell(size * size);
+        for (int r = 0; r < size; ++r)
         {
-            bool colWin = true;
-            for (int i = 0; i < size; ++i)
+            for (int c = 0; c < size; ++c)
             {
-                if (grid[i][j] != symbol)
+                built->allCells.set(r * size + c);
+                for (int d = 0; d < 4; ++d)
                 {
-                    colWin = false;
-                    break;
+                    int endRow = r + dr[d] * (winLength - 1);
+                    int endCol = c + dc[d] * (winLength - 1);
+                    if (endRow < 0 || endRow >= size || endCol < 0 || endCol >= size)
+                    {
+                        continue; // line would leave the board
+                    }
+                    Cells mask;
+                    for (int i = 0; i < winLength; ++i)
+                    {
+                        int cell = (r + dr[d] * i) * size + (c + dc[d] * i);
+                        mask.set(cell);
+                        masksOfCell[cell].push_back((int)built->masks.size());
+                    }
+                    built->masks.push_back(mask);
                 }
             }
-            if (colWin)
+        }
+        for (int cell = 0; cell < size * size; ++cell)
+        {
+            built->cellStart.push_back((int)built->cellMasks.size());
+            built->cellMasks.insert(built->cellMasks.end(), masksOfCell[cell].begin(), masksOfCell[cell].end());
+        }
+        built->cellStart.push_back((int)built->cellMasks.size());
+        cached = built;
+        return cached;
+    }
+
+    // Map a symbol to player 0 or 1 (first two symbols seen); -1 for a third symbol
+    int playerIndex(char symbol)
+    {
+        for (int p = 0; p < 2; ++p)
+        {
+            if (symbols[p] == ' ')
+            {
+                symbols[p] = symbol;
+            }
+            if (symbols[p] == symbol)
             {
-                return true;
+                return p;
             }
         }
+        return -1;
+    }
 
-        // Check main diagonal (top-left to bottom-right)
-        bool mainDiagWin = true;
-        for (int i = 0; i < size; ++i)
+    // Same lookup without registering the symbol
+    int findPlayer(char symbol) const
+    {
+        for (int p = 0; p < 2; ++p)
         {
-            if (grid[i][i] != symbol)
+            if (symbols[p] == symbol)
             {
-                mainDiagWin = false;
-                break;
+                return p;
             }
         }
-        if (mainDiagWin)
+        return -1;
+    }
+
+    // Symbol shown for a cell
+    char symbolAt(int cell) const
+    {
+        if (cells[0].test(cell))
         {
-            return true;
+            return symbols[0];
         }
-
-        // Check anti-diagonal (top-right to bottom-left)
-        bool antiDiagWin = true;
-        for (int i = 0; i < size; ++i)
+        if (cells[1].test(cell))
         {
-            if (grid[i][size - 1 - i] != symbol)
-            {
-                antiDiagWin = false;
-                break;
-            }
+            return symbols[1];
         }
-        if (antiDiagWin)
+        return ' ';
+    }
+
+public:
+    // Constructor: size x size board where k = winLength in a row wins (0 -> full line)
+    // Throws invalid_argument unless 1 <= n <= MAX_SIZE
+    BitBoard(int n = 3, int k = 0)
+    {
+        if (n < 1 || n > MAX_SIZE)
         {
-            return true;
+            throw invalid_argument("BitBoard size must be between 1 and " + to_string(MAX_SIZE));
         }
+        size = n;
+        winLength = (k < 1 || k > size) ? size : k;
+        winMasks = winMasksFor(size, winLength);
+        reset();
+    }
 
-        // If none of the lines had all same symbols, no win
-        return false;
+    int getSize() const
+    {
+        return size;
     }
 
-    // Check if the board is completely filled (used for detecting draw)
-    bool isFull() const
+    int getWinLength() const
+    {
+        return winLength;
+    }
+
+    // Symbol at (row, col), ' ' if empty
+    char getCell(int row, int col) const
+    {
+        return symbolAt(row * size + col);
+    }
+
+    // Win lines of this board shape
+    shared_ptr<const WinMasks> getWinMasks() const
+    {
+        return winMasks;
+    }
+
+    // Display the board in a user-friendly format (same layout as Board)
+    void printBoard() const
     {
+        cout << "\nCurrent Board:\n";
         for (int i = 0; i < size; ++i)
         {
             for (int j = 0; j < size; ++j)
             {
-                if (grid[i][j] == ' ')
+                cout << " " << symbolAt(i * size + j) << " ";
+                if (j < size - 1)
                 {
-                    // Found at least one empty cell, not full
-                    return false;
+                    cout << "|";
                 }
             }
-        }
-        // No empty cell found -> board is full
-        return true;
-    }
-
-    // Optional: reset board to empty state (not strictly required here)
-    void reset()
-    {
-        for (int i = 0; i < size; ++i)
-        {
-            for (int j = 0; j < size; ++j)
+            cout << "\n";
+            if (i < size - 1)
             {
-                grid[i][j] = ' ';
+                for (int k = 0; k < size; ++k)
+                {
+                    cout << "---";
+                    if (k < size - 1)
+                    {
+                        cout << "+";
+                    }
+                }
+                cout << "\n";
             }
         }
+        cout << "\n";
     }
-};
 
-// ----------------------------------------------------------
-// Game class: controls the overall flow of the Tic-Tac-Toe game
-// ----------------------------------------------------------
-class Game
-{
-private:
-    Board board;           // The game board
-    Player player1;        // First player
-    Player player2;        // Second player
-    Player *currentPlayer; // Pointer to the player whose turn it is
+    // Check if given (row, col) indices are within the board bounds
+    bool isValidPosition(int row, int col) const
+    {
+        return (row >= 0 && row < size && col >= 0 && col < size);
+    }
 
-public:
-    // Constructor: initialize board and players
-    Game()
-        : board(3),                 // create a 3x3 board
-          player1("Player 1", 'X'), // player 1 uses symbol 'X'
-          player2("Player 2", 'O')  // player 2 uses symbol 'O'
+    // Check if a cell at (row, col) is empty
+    bool isCellEmpty(int row, int col) const
     {
-        // At the beginning, let player1 start
-        currentPlayer = &player1;
+        if (!isValidPosition(row, col))
+        {
+            return false;
+        }
+        int cell = row * size + col;
+        return !cells[0].test(cell) && !cells[1].test(cell);
     }
 
-    // Switch the current player pointer from one to the other
-    void switchPlayer()
+    // Place a symbol at the given (row, col); false if invalid or occupied
+    bool placeSymbol(int row, int col, char symbol)
     {
-        if (currentPlayer == &player1)
+        if (!isCellEmpty(row, col))
         {
-            currentPlayer = &player2;
+            return false;
         }
-        else
+        int player = playerIndex(symbol);
+        if (player < 0)
         {
-            currentPlayer = &player1;
+            return false;
         }
+        play(row * size + col, player);
+        return true;
     }
 
-    // Main game loop
-    void start()
+    // Undo the move at (row, col); false if the cell is out of bounds or empty
+    bool undo(int row, int col)
     {
-        cout << "Welcome to Tic-Tac-Toe (3x3)!\n";
-        cout << player1.getName() << " will be '" << player1.getSymbol() << "'.\n";
-        cout << player2.getName() << " will be '" << player2.getSymbol() << "'.\n\n";
-
-        // Infinite loop until we break when game is over
-        while (true)
+        if (!isValidPosition(row, col) || isCellEmpty(row, col))
         {
-            // Display the board at the start of each turn
-            board.printBoard();
-
-            // Ask the current player for their move
-            cout << currentPlayer->getName() << "'s turn. Symbol: " << currentPlayer->getSymbol() << "\n";
-            cout << "Enter row and column (1-based indexing, e.g., 1 1 for top-left): ";
+            return false;
+        }
+        int cell = row * size + col;
+        unplay(cell, cells[0].test(cell) ? 0 : 1);
+        return true;
+    }
 
-            int rowInput, colInput;
-            cin >> rowInput >> colInput;
+    // Check if a given symbol has won the game
+    bool checkWin(char symbol) const
+    {
+        int player = findPlayer(symbol);
+        return player >= 0 && won[player];
+    }
 
-            // Convert from 1-based input to 0-based indices used internally
-            int row = rowInput - 1;
-            int col = colInput - 1;
+    // Check if the board is completely filled
+    bool isFull() const
+    {
+        return moveCount == size * size;
+    }
 
-            // Try to place the symbol on the board
-            bool moveSuccessful = board.placeSymbol(row, col, currentPlayer->getSymbol());
+    // Reset board to empty state
+    void reset()
+    {
+        for (int p = 0; p < 2; ++p)
+        {
+            cells[p].reset();
+            symbols[p] = ' ';
+            won[p] = false;
+        }
+        moveCount = 0;
+    }
 
-            if (!moveSuccessful)
-            {
-                // If placement failed, it means invalid position or already occupied
-                cout << "Invalid move. Please try again.\n\n";
-                // Do not switch player, ask same player again
-                continue;
-            }
+    // --- Fast interface for search / simulation (no bounds or symbol checks) ---
 
-            // After a successful move, check if the current player has won
-            if (board.checkWin(currentPlayer->getSymbol()))
+    // Put 'player' (0 or 1) on an empty cell; returns true if the move wins
+    bool play(int cell, int player)
+    {
+        cells[player].set(cell);
+        ++moveCount;
+        const WinMasks &w = *winMasks;
+        for (int i = w.cellStart[cell]; i < w.cellStart[cell + 1]; ++i)
+        {
+            const Cells &mask = w.masks[w.cellMasks[i]];
+            if ((cells[player] & mask) == mask)
             {
-                board.printBoard();
-                cout << currentPlayer->getName() << " wins the game!\n";
-                break; // end the game loop
+                won[player] = true;
+                return true;
             }
+        }
+        return false;
+    }
 
-            // If no win, check if the board is full -> draw
-            if (board.isFull())
+    // Take back a move made with play()
+    void unplay(int cell, int player)
+    {
+        cells[player].reset(cell);
+        --moveCount;
+        if (!won[player])
+        {
+            return;
+        }
+        // Rare: the player had a line; recheck whether another one is still complete
+        won[player] = false;
+        for (const Cells &mask : winMasks->masks)
+        {
+            if ((cells[player] & mask) == mask)
             {
-                board.printBoard();
-                cout << "The game is a draw. No more empty cells.\n";
-                break; // end the game loop
+                won[player] = true;
+                break;
+            }
+        }
+    }
+
+    // True if 'player' has completed a line
+    bool hasWon(int player) const
+    {
+        return won[player];
+    }
+
+    // Cells owned by a player, and the empty cells of the board
+    const Cells &getCells(int player) const
+    {
+        return cells[player];
+    }
+
+    Cells getEmptyCells() const
+    {
+        return winMasks->allCells & ~(cells[0] | cells[1]);
+    }
+
+    int getMoveCount() const
+    {
+        return moveCount;
+    }
+
+    // Symbol registered for player 0 / 1 (' ' if none yet); lets a fast-path
+    // caller map the players back to placeSymbol's symbols
+    char getSymbol(int player) const
+    {
+        return symbols[player];
+    }
+
+    void setSymbol(int player, char symbol)
+    {
+        symbols[player] = symbol;
+    }
+};
+
+// ----------------------------------------------------------
+// AIPlayer class: computer opponent (alpha-beta search)
+// ----------------------------------------------------------
+// Iterative-deepening negamax with alpha-beta pruning for size x size
+// boards with k in a row, within a per-move time budget:
+//  - Transposition table: Zobrist hash -> (depth, score, bound, best move),
+//    shared by all search threads and lock-free (an entry is stored as
+//    key ^ data plus data, so a torn write never validates)
+//  - Move ordering: table move first, then cells that extend or block the
+//    most open lines, then the history heuristic; only empty cells next to
+//    a stone are searched
+//  - Evaluation: every line still open to one player only is worth
+//    4^stones for that player, kept up to date on each move/undo
+//  - Lazy SMP: all threads search the same root with staggered depths and
+//    share the table; the main thread's deepest completed result is played
+// Works with any board that offers getSize(), getWinLength() and getCell().
+class AIPlayer
+{
+private:
+    static constexpr int WIN_SCORE = 1000000000; // a win at ply p scores WIN_SCORE - p
+    static constexpr int INF = WIN_SCORE + 1;
+    static constexpr int MAX_PLY = BitBoard::MAX_CELLS + 1;
+    static constexpr int MAX_DEPTH = 64;
+    typedef BitBoard::Cells Cells;
+
+    enum Bound
+    {
+        EXACT,
+        LOWER, // score is at least this (beta cutoff)
+        UPPER  // score is at most this (no move raised alpha)
+    };
+
+    struct TTEntry
+    {
+        atomic<uint64_t> check{0}; // key ^ data
+        atomic<uint64_t> data{0};  // score | depth << 32 | bound << 40 | (move + 1) << 48
+    };
+
+    // Random keys per (player, cell) plus one for the side to move.
+    // Stones are labelled relative to the root mover, so the side key is
+    // toggled by search moves only: it means "player 1 to move".
+    struct Zobrist
+    {
+        uint64_t cells[2][BitBoard::MAX_CELLS];
+        uint64_t side;
+
+        Zobrist()
+        {
+            mt19937_64 random(20240601);
+            for (int p = 0; p < 2; ++p)
+            {
+                for (int c = 0; c < BitBoard::MAX_CELLS; ++c)
+                {
+                    cells[p][c] = random();
+                }
+            }
+            side = random();
+        }
+    };
+
+    static const Zobrist &zobrist()
+    {
+        static const Zobrist keys;
+        return keys;
+    }
+
+    // Line weight by stone count (capped so the evaluation stays well below WIN_SCORE)
+    static int lineWeight(int stones)
+    {
+        return stones == 0 ? 0 : 1 << (2 * min(stones, 9));
+    }
+
+    // Position being searched and the search itself, one per thread.
+    // Player 0 is always the side to move at the root.
+    class Searcher
+    {
+    private:
+        AIPlayer &ai;
+        shared_ptr<const BitBoard::WinMasks> winMasks;
+        int size, winLength, cellCount;
+        Cells occupied[2];
+        vector<uint8_t> lineCounts;     // lineCounts[player * lineCount + line]
+        int lineCount;
+        int score;                      // evaluation for player 0
+        int moveCount;
+        uint64_t key;
+        vector<Cells> neighbours;       // cells within one step of each cell
+        vector<int> history[2];         // cutoffs per (player, cell), for ordering
+        uint64_t nodes;
+
+        int lineValue(int line) const
+        {
+            int mine = lineCounts[line], theirs = lineCounts[lineCount + line];
+            if (mine && theirs)
+            {
+                return 0; // blocked for both
+            }
+            return mine ? lineWeight(mine) : -lineWeight(theirs);
+        }
+
+        // Play 'cell' for 'player'; returns true if it completes a line
+        bool makeMove(int cell, int player)
+        {
+            const BitBoard::WinMasks &w = *winMasks;
+            bool win = false;
+            occupied[player].set(cell);
+            key ^= zobrist().cells[player][cell] ^ zobrist().side;
+            ++moveCount;
+            for (int i = w.cellStart[cell]; i < w.cellStart[cell + 1]; ++i)
+            {
+                int line = w.cellMasks[i];
+                score -= lineValue(line);
+                if (++lineCounts[player * lineCount + line] == winLength)
+                {
+                    win = true;
+                }
+                score += lineValue(line);
+            }
+            return win;
+        }
+
+        void undoMove(int cell, int player)
+        {
+            const BitBoard::WinMasks &w = *winMasks;
+            occupied[player].reset(cell);
+            key ^= zobrist().cells[player][cell] ^ zobrist().side;
+            --moveCount;
+            for (int i = w.cellStart[cell]; i < w.cellStart[cell + 1]; ++i)
+            {
+                int line = w.cellMasks[i];
+                score -= lineValue(line);
+                --lineCounts[player * lineCount + line];
+                score += lineValue(line);
+            }
+        }
+
+        // How much a move at 'cell' extends the mover's lines and blocks the opponent's
+        long long movePriority(int cell, int player) const
+        {
+            const BitBoard::WinMasks &w = *winMasks;
+            long long priority = history[player][cell];
+            for (int i = w.cellStart[cell]; i < w.cellStart[cell + 1]; ++i)
+            {
+                int line = w.cellMasks[i];
+                int mine = lineCounts[player * lineCount + line];
+                int theirs = lineCounts[(1 - player) * lineCount + line];
+                if (theirs == 0)
+                {
+                    priority += 4LL << (2 * mine); // attack
+                }
+                if (mine == 0)
+                {
+                    priority += 3LL << (2 * theirs); // defence, slightly below an equal attack
+                }
+            }
+            return priority;
+        }
+
+        // Empty cells next to a stone, best first; only the centre on an empty board
+        int generateMoves(int player, int ttMove, int *moves) const
+        {
+            if (moveCount == 0)
+            {
+                moves[0] = (size / 2) * size + size / 2;
+                return 1;
+            }
+            Cells stones = occupied[0] | occupied[1];
+            pair<long long, int> ranked[BitBoard::MAX_CELLS];
+            int count = 0;
+            for (int cell = 0; cell < cellCount; ++cell)
+            {
+                if (stones.test(cell) || (stones & neighbours[cell]).none())
+                {
+                    continue;
+                }
+                long long priority = cell == ttMove ? LLONG_MAX : movePriority(cell, player);
+                ranked[count++] = make_pair(priority, cell);
+            }
+            sort(ranked, ranked + count, [](const pair<long long, int> &a, const pair<long long, int> &b)
+                 { return a.first > b.first; });
+            for (int i = 0; i < count; ++i)
+            {
+                moves[i] = ranked[i].second;
+            }
+            return count;
+        }
+
+        // True once the shared stop flag is set or the time budget is spent
+        bool timeUp()
+        {
+            if (ai.stop.load(memory_order_relaxed))
+            {
+                return true;
+            }
+            if ((++nodes & 1023) == 0 && chrono::steady_clock::now() >= ai.deadline)
+            {
+                ai.stop.store(true, memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        int negamax(int depth, int alpha, int beta, int ply, int player)
+        {
+            if (timeUp() && !mustFinish)
+            {
+                return 0;
+            }
+            if (depth == 0)
+            {
+                return player == 0 ? score : -score;
+            }
+
+            // Transposition table probe (win scores are stored relative to this node)
+            int ttMove = -1;
+            int ttScore, ttDepth, ttBound;
+            if (ai.probe(key, ttScore, ttDepth, ttBound, ttMove))
+            {
+                if (ttScore > WIN_SCORE - MAX_PLY)
+                {
+                    ttScore -= ply;
+                }
+                else if (ttScore < -WIN_SCORE + MAX_PLY)
+                {
+                    ttScore += ply;
+                }
+                if (ttDepth >= depth && ply > 0)
+                {
+                    if (ttBound == EXACT)
+                    {
+                        return ttScore;
+                    }
+                    if (ttBound == LOWER)
+                    {
+                        alpha = max(alpha, ttScore);
+                    }
+                    else
+                    {
+                        beta = min(beta, ttScore);
+                    }
+                    if (alpha >= beta)
+                    {
+                        return ttScore;
+                    }
+                }
+            }
+
+            int moves[BitBoard::MAX_CELLS];
+            int count = generateMoves(player, ttMove, moves);
+            int alphaOriginal = alpha;
+            int best = -INF, bestMove = -1;
+            for (int i = 0; i < count; ++i)
+            {
+                int cell = moves[i];
+                int value;
+                if (makeMove(cell, player))
+                {
+                    value = WIN_SCORE - (ply + 1);
+                }
+                else if (moveCount == cellCount)
+                {
+                    value = 0; // board full: draw
+                }
+                else
+                {
+                    value = -negamax(depth - 1, -beta, -alpha, ply + 1, 1 - player);
+                }
+                undoMove(cell, player);
+                if (ai.stop.load(memory_order_relaxed) && !mustFinish)
+                {
+                    return 0;
+                }
+                if (value > best)
+                {
+                    best = value;
+                    bestMove = cell;
+                }
+                if (value > alpha)
+                {
+                    alpha = value;
+                }
+                if (alpha >= beta)
+                {
+                    history[player][cell] += depth * depth;
+                    break;
+                }
+            }
+            if (ply == 0)
+            {
+                rootMove = bestMove;
+            }
+
+            int stored = best;
+            if (stored > WIN_SCORE - MAX_PLY)
+            {
+                stored += ply;
+            }
+            else if (stored < -WIN_SCORE + MAX_PLY)
+            {
+                stored -= ply;
+            }
+            int bound = best <= alphaOriginal ? UPPER : (best >= beta ? LOWER : EXACT);
+            ai.store(key, stored, depth, bound, bestMove);
+            return best;
+        }
+
+    public:
+        int rootMove = -1;
+        bool mustFinish = false; // depth 1 always completes, so there is always a move
+
+        Searcher(AIPlayer &ai, shared_ptr<const BitBoard::WinMasks> masks, int size, int winLength)
+            : ai(ai), winMasks(masks), size(size), winLength(winLength), cellCount(size * size),
+              lineCount((int)masks->masks.size()), score(0), moveCount(0), key(0), nodes(0)
+        {
+            lineCounts.assign(2 * lineCount, 0);
+            neighbours.resize(cellCount);
+            for (int r = 0; r < size; ++r)
+            {
+                for (int c = 0; c < size; ++c)
+                {
+                    for (int dr = -1; dr <= 1; ++dr)
+                    {
+                        for (int dc = -1; dc <= 1; ++dc)
+                        {
+                            int nr = r + dr, nc = c + dc;
+                            if ((dr || dc) && nr >= 0 && nr < size && nc >= 0 && nc < size)
+                            {
+                                neighbours[r * size + c].set(nr * size + nc);
+                            }
+                        }
+                    }
+                }
+            }
+            history[0].assign(cellCount, 0);
+            history[1].assign(cellCount, 0);
+        }
+
+        // Board shape this searcher was built for
+        bool hasShape(int boardSize, int boardWinLength) const
+        {
+            return size == boardSize && winLength == boardWinLength;
+        }
+
+        // Back to an empty board, keeping the allocations (and the history table)
+        void clear()
+        {
+            occupied[0].reset();
+            occupied[1].reset();
+            fill(lineCounts.begin(), lineCounts.end(), 0);
+            score = 0;
+            moveCount = 0;
+            key = 0;
+            nodes = 0;
+        }
+
+        // Set up the root position (player 0 = side to move); root stones do
+        // not toggle the side key, since the root mover is always player 0
+        void place(int cell, int player)
+        {
+            makeMove(cell, player);
+            key ^= zobrist().side;
+        }
+
+        int getMoveCount() const
+        {
+            return moveCount;
+        }
+
+        uint64_t getNodes() const
+        {
+            return nodes;
+        }
+
+        // One iteration at a fixed depth; returns the root score
+        int search(int depth)
+        {
+            mustFinish = depth == 1;
+            return negamax(depth, -INF, INF, 0, 0);
+        }
+    };
+
+    int moveTimeMs;          // time budget per move
+    int maxDepth = MAX_DEPTH; // depth limit per move (fixed-depth play for simulations)
+    int threadCount;         // search threads (Lazy SMP)
+    vector<unique_ptr<Searcher>> searchers; // one per thread, reused while the board shape stays the same
+    vector<TTEntry> table;   // shared transposition table (power-of-two size)
+    atomic<bool> stop{false};
+    chrono::steady_clock::time_point deadline;
+    int lastDepth = 0;       // depth of the last completed iteration
+    uint64_t lastNodes = 0;  // nodes searched for the last move (all threads)
+
+    bool probe(uint64_t key, int &score, int &depth, int &bound, int &move) const
+    {
+        const TTEntry &entry = table[key & (table.size() - 1)];
+        uint64_t data = entry.data.load(memory_order_relaxed);
+        if ((entry.check.load(memory_order_relaxed) ^ data) != key)
+        {
+            return false;
+        }
+        score = (int32_t)(uint32_t)data;
+        depth = (int)((data >> 32) & 0xFF);
+        bound = (int)((data >> 40) & 0xFF);
+        move = (int)((data >> 48) & 0xFFFF) - 1;
+        return true;
+    }
+
+    void store(uint64_t key, int score, int depth, int bound, int move)
+    {
+        TTEntry &entry = table[key & (table.size() - 1)];
+        uint64_t data = (uint64_t)(uint32_t)score | (uint64_t)depth << 32 | (uint64_t)bound << 40 |
+                        (uint64_t)(move + 1) << 48;
+        entry.check.store(key ^ data, memory_order_relaxed);
+        entry.data.store(data, memory_order_relaxed);
+    }
+
+public:
+    // Constructor: time budget per move, search threads (0 = all cores), table size
+    AIPlayer(int moveTimeMs = 1000, int threads = 0, int tableBits = 20)
+        : moveTimeMs(moveTimeMs), table(size_t(1) << tableBits)
+    {
+        threadCount = threads > 0 ? threads : (int)max(1u, thread::hardware_concurrency());
+    }
+
+    // Forget earlier positions (e.g. between unrelated games)
+    void clear()
+    {
+        for (TTEntry &entry : table)
+        {
+            entry.check.store(0, memory_order_relaxed);
+            entry.data.store(0, memory_order_relaxed);
+        }
+    }
+
+    // Stop deepening at 'depth' plies even if time is left
+    void setMaxDepth(int depth)
+    {
+        maxDepth = max(1, min(depth, (int)MAX_DEPTH));
+    }
+
+    int getLastDepth() const
+    {
+        return lastDepth;
+    }
+
+    uint64_t getLastNodes() const
+    {
+        return lastNodes;
+    }
+
+    // Pick a move for 'symbol' on 'board'; false if the board has no empty cell
+    template <typename BoardType>
+    bool chooseMove(const BoardType &board, char symbol, int &row, int &col)
+    {
+        int size = board.getSize();
+        if (searchers.empty() || !searchers[0]->hasShape(size, board.getWinLength()))
+        {
+            shared_ptr<const BitBoard::WinMasks> masks = BitBoard(size, board.getWinLength()).getWinMasks();
+            searchers.clear();
+            for (int t = 0; t < threadCount; ++t)
+            {
+                searchers.emplace_back(new Searcher(*this, masks, size, board.getWinLength()));
+            }
+        }
+
+        // Every thread starts from the current position
+        for (int t = 0; t < threadCount; ++t)
+        {
+            searchers[t]->clear();
+            for (int r = 0; r < size; ++r)
+            {
+                for (int c = 0; c < size; ++c)
+                {
+                    char cell = board.getCell(r, c);
+                    if (cell != ' ')
+                    {
+                        searchers[t]->place(r * size + c, cell == symbol ? 0 : 1);
+                    }
+                }
+            }
+        }
+        int emptyCells = size * size - searchers[0]->getMoveCount();
+        if (emptyCells == 0)
+        {
+            return false;
+        }
+
+        stop.store(false);
+        deadline = chrono::steady_clock::now() + chrono::milliseconds(moveTimeMs);
+        int depthLimit = min(emptyCells, maxDepth);
+
+        // Helpers: iterate from staggered depths so they fill the table ahead of the main thread
+        vector<thread> helpers;
+        for (int t = 1; t < threadCount; ++t)
+        {
+            helpers.emplace_back([this, t, depthLimit]()
+                                 {
+                for (int depth = 1 + (t & 1); depth <= depthLimit && !stop.load(); ++depth)
+                {
+                    searchers[t]->search(depth);
+                } });
+        }
+
+        // Main thread: the last fully searched depth decides the move
+        int bestMove = -1;
+        lastDepth = 0;
+        for (int depth = 1; depth <= depthLimit; ++depth)
+        {
+            int value = searchers[0]->search(depth);
+            if (stop.load() && depth > 1)
+            {
+                break; // unfinished iteration
+            }
+            bestMove = searchers[0]->rootMove;
+            lastDepth = depth;
+            if (value > WIN_SCORE - MAX_PLY || value < -WIN_SCORE + MAX_PLY)
+            {
+                break; // forced result found
+            }
+        }
+        stop.store(true);
+        for (thread &helper : helpers)
+        {
+            helper.join();
+        }
+        lastNodes = 0;
+        for (const unique_ptr<Searcher> &searcher : searchers)
+        {
+            lastNodes += searcher->getNodes();
+        }
+
+        row = bestMove / size;
+        col = bestMove % size;
+        return bestMove >= 0;
+    }
+};
+
+// ----------------------------------------------------------
+// Game class: controls the overall flow of the Tic-Tac-Toe game
+// BoardType is the backend: Board (char grid) or BitBoard
+// ----------------------------------------------------------
+template <typename BoardType = Board>
+class Game
+{
+private:
+    BoardType board;       // The game board
+    Player player1;        // First player
+    Player player2;        // Second player
+    Player *currentPlayer; // Pointer to the player whose turn it is
+
+public:
+    // Constructor: initialize board and players
+    // Pass an AIPlayer for a player to let the computer play that side
+    Game(const BoardType &startBoard = BoardType(3), AIPlayer *ai1 = nullptr, AIPlayer *ai2 = nullptr)
+        : board(startBoard),             // 3x3 board unless another is given
+          player1("Player 1", 'X', ai1), // player 1 uses symbol 'X'
+          player2("Player 2", 'O', ai2)  // player 2 uses symbol 'O'
+    {
+        // At the beginning, let player1 start
+        currentPlayer = &player1;
+    }
+
+    // Switch the current player pointer from one to the other
+    void switchPlayer()
+    {
+        if (currentPlayer == &player1)
+        {
+            currentPlayer = &player2;
+        }
+        else
+        {
+            currentPlayer = &player1;
+        }
+    }
+
+    // Main game loop
+    void start()
+    {
+        cout << "Welcome to Tic-Tac-Toe (" << board.getSize() << "x" << board.getSize()
+             << ", " << board.getWinLength() << " in a row)!\n";
+        cout << player1.getName() << " will be '" << player1.getSymbol() << "'.\n";
+        cout << player2.getName() << " will be '" << player2.getSymbol() << "'.\n\n";
+
+        // Infinite loop until we break when game is over
+        while (true)
+        {
+            // Display the board at the start of each turn
+            board.printBoard();
+
+            // Ask the current player for their move
+            cout << currentPlayer->getName() << "'s turn. Symbol: " << currentPlayer->getSymbol() << "\n";
+
+            int row = -1, col = -1;
+            if (currentPlayer->getAI())
+            {
+                // Computer player: search within its time budget
+                currentPlayer->getAI()->chooseMove(board, currentPlayer->getSymbol(), row, col);
+                cout << currentPlayer->getName() << " plays " << row + 1 << " " << col + 1
+                     << " (depth " << currentPlayer->getAI()->getLastDepth() << ")\n";
+            }
+            else
+            {
+                cout << "Enter row and column (1-based indexing, e.g., 1 1 for top-left): ";
+
+                int rowInput, colInput;
+                if (!(cin >> rowInput >> colInput))
+                {
+                    cout << "\nInput ended.\n";
+                    break;
+                }
+
+                // Convert from 1-based input to 0-based indices used internally
+                row = rowInput - 1;
+                col = colInput - 1;
+            }
+
+            // Try to place the symbol on the board
+            bool moveSuccessful = board.placeSymbol(row, col, currentPlayer->getSymbol());
+
+            if (!moveSuccessful)
+            {
+                // If placement failed, it means invalid position or already occupied
+                cout << "Invalid move. Please try again.\n\n";
+                // Do not switch player, ask same player again
+                continue;
+            }
+
+            // After a successful move, check if the current player has won
+            if (board.checkWin(currentPlayer->getSymbol()))
+            {
+                board.printBoard();
+                cout << currentPlayer->getName() << " wins the game!\n";
+                break; // end the game loop
+            }
+
+            // If no win, check if the board is full -> draw
+            if (board.isFull())
+            {
+                board.printBoard();
+                cout << "The game is a draw. No more empty cells.\n";
+                break; // end the game loop
             }
 
             // If no win and not draw, switch to the other player and continue the loop
@@ -321,13 +1296,387 @@ public:
     }
 };
 
+// ----------------------------------------------------------
+// MovePolicy classes: pluggable move choosers for self-play
+// ----------------------------------------------------------
+// A policy picks a cell for 'player' (0 or 1) on a BitBoard. Each
+// simulator worker owns its own policy objects, so a policy may keep
+// state (like the AI's transposition table) without locking.
+class MovePolicy
+{
+public:
+    virtual ~MovePolicy() {}
+
+    // Cell index (row * size + col) of an empty cell; the board must not be full
+    virtual int chooseCell(const BitBoard &board, int player, mt19937_64 &random) = 0;
+};
+
+// Uniformly random empty cell
+class RandomPolicy : public MovePolicy
+{
+public:
+    int chooseCell(const BitBoard &board, int, mt19937_64 &random) override
+    {
+        BitBoard::Cells empty = board.getEmptyCells();
+        int target = (int)(random() % empty.count());
+        for (int cell = 0;; ++cell)
+        {
+            if (empty.test(cell) && target-- == 0)
+            {
+                return cell;
+            }
+        }
+    }
+};
+
+// Win if possible, else block the opponent's win, else take the cell that
+// extends / blocks the most open lines (random among equals)
+class HeuristicPolicy : public MovePolicy
+{
+public:
+    int chooseCell(const BitBoard &board, int player, mt19937_64 &random) override
+    {
+        const BitBoard::WinMasks &w = *board.getWinMasks();
+        const BitBoard::Cells &mine = board.getCells(player);
+        const BitBoard::Cells &theirs = board.getCells(1 - player);
+        BitBoard::Cells empty = board.getEmptyCells();
+        int winLength = board.getWinLength();
+        int cellCount = board.getSize() * board.getSize();
+
+        int bestCell = -1, ties = 0;
+        long long bestScore = -1;
+        for (int cell = 0; cell < cellCount; ++cell)
+        {
+            if (!empty.test(cell))
+            {
+                continue;
+            }
+            long long score = 0;
+            for (int i = w.cellStart[cell]; i < w.cellStart[cell + 1]; ++i)
+            {
+                const BitBoard::Cells &mask = w.masks[w.cellMasks[i]];
+                int myCount = (int)(mine & mask).count();
+                int theirCount = (int)(theirs & mask).count();
+                if (theirCount == 0)
+                {
+                    score += myCount + 1 == winLength ? (1LL << 50) : (4LL << (2 * myCount));
+                }
+                if (myCount == 0)
+                {
+                    score += theirCount + 1 == winLength ? (1LL << 40) : (3LL << (2 * theirCount));
+                }
+            }
+            // Reservoir sampling keeps ties uniformly random
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestCell = cell;
+                ties = 1;
+            }
+            else if (score == bestScore && random() % ++ties == 0)
+            {
+                bestCell = cell;
+            }
+        }
+        return bestCell;
+    }
+};
+
+// Alpha-beta search at a fixed depth (single-threaded; the simulator supplies the parallelism).
+// Each table holds positions with either side to move (negamax stores every
+// node it searches). One engine per board player keeps the two players'
+// searches from overwriting each other's entries; tables are kept across
+// games, which is what makes fixed-depth self-play fast.
+class AIPolicy : public MovePolicy
+{
+private:
+    AIPlayer ai[2] = {{60000, 1, 16}, {60000, 1, 16}};
+
+public:
+    AIPolicy(int depth)
+    {
+        ai[0].setMaxDepth(depth);
+        ai[1].setMaxDepth(depth);
+    }
+
+    int chooseCell(const BitBoard &board, int player, mt19937_64 &) override
+    {
+        int row, col;
+        if (!ai[player].chooseMove(board, board.getSymbol(player), row, col))
+        {
+            throw logic_error("AIPolicy asked to move on a full board");
+        }
+        return row * board.getSize() + col;
+    }
+};
+
+// ----------------------------------------------------------
+// SelfPlaySimulator class: headless batch games on a thread pool
+// ----------------------------------------------------------
+// Plays 'games' games between two policies, alternating who moves first.
+// Workers claim games in batches from a shared counter, reuse one
+// preallocated BitBoard and their own policy objects, and count results
+// in thread-local totals that are summed at the end, so the game loop
+// does not allocate (the AI policy reuses its search state as well).
+class SelfPlaySimulator
+{
+public:
+    enum PolicyType
+    {
+        RANDOM,
+        HEURISTIC,
+        AI
+    };
+
+    // Aggregated results; "first" = the policy that moved first in that game
+    struct Stats
+    {
+        uint64_t games = 0;
+        uint64_t wins[2] = {0, 0};       // wins of policy 1 / policy 2
+        uint64_t draws = 0;
+        uint64_t firstMoverWins = 0;
+        uint64_t moves = 0;
+        double seconds = 0;
+    };
+
+private:
+    static constexpr uint64_t GAMES_PER_CLAIM = 64;
+
+    int size, winLength;
+    PolicyType policyTypes[2];
+    int aiDepth;
+    int threadCount;
+    uint64_t seed;
+
+    unique_ptr<MovePolicy> makePolicy(PolicyType type) const
+    {
+        if (type == AI)
+        {
+            return unique_ptr<MovePolicy>(new AIPolicy(aiDepth));
+        }
+        if (type == HEURISTIC)
+        {
+            return unique_ptr<MovePolicy>(new HeuristicPolicy());
+        }
+        return unique_ptr<MovePolicy>(new RandomPolicy());
+    }
+
+    // Per-thread totals, padded so workers never share a cache line
+    struct alignas(64) WorkerStats
+    {
+        Stats stats;
+    };
+
+    void runWorker(int index, uint64_t totalGames, atomic<uint64_t> &nextGame, WorkerStats &out) const
+    {
+        unique_ptr<MovePolicy> policies[2] = {makePolicy(policyTypes[0]), makePolicy(policyTypes[1])};
+        mt19937_64 random(seed + 0x9E3779B97F4A7C15ULL * (index + 1));
+        BitBoard board(size, winLength);
+        Stats &stats = out.stats;
+        int cellCount = board.getSize() * board.getSize();
+
+        while (true)
+        {
+            uint64_t first = nextGame.fetch_add(GAMES_PER_CLAIM);
+            if (first >= totalGames)
+            {
+                break;
+            }
+            uint64_t last = min(totalGames, first + GAMES_PER_CLAIM);
+            for (uint64_t game = first; game < last; ++game)
+            {
+                // Board player 0 moves first; odd games let policy 2 start
+                int firstPolicy = (int)(game & 1);
+                board.reset();
+                board.setSymbol(0, 'X');
+                board.setSymbol(1, 'O');
+                int player = 0, result = -1; // result: winning board player, -1 = draw
+                while (board.getMoveCount() < cellCount)
+                {
+                    int policy = player == 0 ? firstPolicy : 1 - firstPolicy;
+                    int cell = policies[policy]->chooseCell(board, player, random);
+                    ++stats.moves;
+                    if (board.play(cell, player))
+                    {
+                        result = player;
+                        break;
+                    }
+                    player = 1 - player;
+                }
+                ++stats.games;
+                if (result < 0)
+                {
+                    ++stats.draws;
+                }
+                else
+                {
+                    ++stats.wins[result == 0 ? firstPolicy : 1 - firstPolicy];
+                    stats.firstMoverWins += result == 0;
+                }
+            }
+        }
+    }
+
+public:
+    SelfPlaySimulator(int size, int winLength, PolicyType policy1, PolicyType policy2,
+                      int aiDepth = 4, int threads = 0, uint64_t seed = 1)
+        : size(size), winLength(winLength), aiDepth(aiDepth), seed(seed)
+    {
+        policyTypes[0] = policy1;
+        policyTypes[1] = policy2;
+        threadCount = threads > 0 ? threads : (int)max(1u, thread::hardware_concurrency());
+    }
+
+    // Parse "random", "heuristic" or "ai"; false for anything else
+    static bool parsePolicy(const string &name, PolicyType &type)
+    {
+        if (name == "random")
+        {
+            type = RANDOM;
+        }
+        else if (name == "heuristic")
+        {
+            type = HEURISTIC;
+        }
+        else if (name == "ai")
+        {
+            type = AI;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // Play 'games' games on all worker threads and return the totals
+    Stats run(uint64_t games) const
+    {
+        vector<WorkerStats> perWorker(threadCount);
+        atomic<uint64_t> nextGame{0};
+        auto start = chrono::steady_clock::now();
+        vector<thread> pool;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            pool.emplace_back([this, t, games, &nextGame, &perWorker]()
+                              { runWorker(t, games, nextGame, perWorker[t]); });
+        }
+        for (thread &worker : pool)
+        {
+            worker.join();
+        }
+
+        Stats total;
+        for (const WorkerStats &worker : perWorker)
+        {
+            total.games += worker.stats.games;
+            total.wins[0] += worker.stats.wins[0];
+            total.wins[1] += worker.stats.wins[1];
+            total.draws += worker.stats.draws;
+            total.firstMoverWins += worker.stats.firstMoverWins;
+            total.moves += worker.stats.moves;
+        }
+        total.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return total;
+    }
+};
+
 // ----------------------------------------------------------
 // main function: entry point of the program
+// Options: --size N, --k K (K in a row wins), --ai1 / --ai2 (computer
+// plays X / O), --time MS (per computer move), --threads T
+// Headless mode: --simulate GAMES [--policy1 P] [--policy2 P] [--depth D]
+// [--seed S] with P = random | heuristic | ai
 // ----------------------------------------------------------
-int main()
+int main(int argc, char *argv[])
 {
-    // Create a Game object
-    Game game;
+    int size = 3, winLength = 0, moveTimeMs = 1000, threads = 0, aiDepth = 4;
+    bool computer1 = false, computer2 = false;
+    uint64_t simulatedGames = 0, seed = 1;
+    SelfPlaySimulator::PolicyType policies[2] = {SelfPlaySimulator::RANDOM, SelfPlaySimulator::RANDOM};
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue)
+        {
+            size = atoi(argv[++i]);
+        }
+        else if (arg == "--k" && hasValue)
+        {
+            winLength = atoi(argv[++i]);
+        }
+        else if (arg == "--time" && hasValue)
+        {
+            moveTimeMs = atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && hasValue)
+        {
+            threads = atoi(argv[++i]);
+        }
+        else if (arg == "--simulate" && hasValue)
+        {
+            simulatedGames = strtoull(argv[++i], nullptr, 10);
+        }
+        else if ((arg == "--policy1" || arg == "--policy2") && hasValue)
+        {
+            if (!SelfPlaySimulator::parsePolicy(argv[++i], policies[arg == "--policy1" ? 0 : 1]))
+            {
+                cout << "Unknown policy: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--depth" && hasValue)
+        {
+            aiDepth = atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue)
+        {
+            seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--ai1")
+        {
+            computer1 = true;
+        }
+        else if (arg == "--ai2")
+        {
+            computer2 = true;
+        }
+        else
+        {
+            cout << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (size < 1 || size > BitBoard::MAX_SIZE)
+    {
+        cout << "Board size must be between 1 and " << BitBoard::MAX_SIZE << "\n";
+        return 1;
+    }
+
+    if (simulatedGames > 0)
+    {
+        // Headless self-play: print the aggregated results only
+        BitBoard shape(size, winLength);
+        SelfPlaySimulator simulator(shape.getSize(), shape.getWinLength(), policies[0], policies[1],
+                                    aiDepth, threads, seed);
+        SelfPlaySimulator::Stats stats = simulator.run(simulatedGames);
+        cout << "Games: " << stats.games << " (" << shape.getSize() << "x" << shape.getSize() << ", "
+             << shape.getWinLength() << " in a row)\n";
+        cout << "Policy 1 wins: " << stats.wins[0] << ", Policy 2 wins: " << stats.wins[1]
+             << ", Draws: " << stats.draws << "\n";
+        cout << "First mover wins: " << stats.firstMoverWins << ", Moves: " << stats.moves << "\n";
+        cout << "Time: " << stats.seconds << " s (" << (stats.seconds > 0 ? stats.games / stats.seconds : 0)
+             << " games/s)\n";
+        return 0;
+    }
+
+    // Computer players share one engine (and its transposition table)
+    AIPlayer ai(moveTimeMs, threads);
+
+    // Create a Game object (bitboard backend; Game<Board> uses the char grid)
+    Game<BitBoard> game(BitBoard(size, winLength), computer1 ? &ai : nullptr, computer2 ? &ai : nullptr);
 
     // Start the game loop
     game.start();
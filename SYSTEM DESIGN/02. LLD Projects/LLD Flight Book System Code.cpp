@@ -2,6 +2,34 @@
 #include <vector>
 #include <ctime>
 #include <iostream>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <string_view>
+#include <deque>
+#include <shared_mutex>
+#include <mutex>
+#include <charconv>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <array>
+#include <random>
+#include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <dirent.h>
 
 using namespace std;
 
@@ -24,25 +52,82 @@ enum class SeatStatus {
     BOOKED
 };
 
+// SymbolTable interns names into dense integer IDs (0, 1, 2, ...). Each name
+// is stored once and never moves, so the string_view returned by intern()
+// stays valid for the life of the program. Entities keep their ID and view,
+// so hot paths compare integers and never copy or look up strings.
+class SymbolTable {
+private:
+    mutable shared_mutex mutex;
+    deque<string> storage;                   // Stable storage for the names
+    vector<string_view> names;               // ID -> name
+    unordered_map<string_view, uint32_t> ids; // Name -> ID
+
+public:
+    // ID of a name, assigning the next one the first time it is seen
+    uint32_t intern(string_view name) {
+        {
+            shared_lock<shared_mutex> lock(mutex);
+            auto it = ids.find(name);
+            if (it != ids.end()) return it->second;
+        }
+        unique_lock<shared_mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it == ids.end()) {
+            storage.emplace_back(name);
+            names.push_back(storage.back());
+            it = ids.emplace(names.back(), static_cast<uint32_t>(names.size() - 1)).first;
+        }
+        return it->second;
+    }
+
+    // ID of an already interned name; false if it was never interned
+    bool find(string_view name, uint32_t& id) const {
+        shared_lock<shared_mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it == ids.end()) return false;
+        id = it->second;
+        return true;
+    }
+
+    string_view name(uint32_t id) const {
+        shared_lock<shared_mutex> lock(mutex);
+        return id < names.size() ? names[id] : string_view();
+    }
+
+    size_t size() const {
+        shared_lock<shared_mutex> lock(mutex);
+        return names.size();
+    }
+};
+
+// Global symbol tables: one ID space per kind of name, so each stays dense
+inline SymbolTable& airportSymbols() { static SymbolTable table; return table; }
+inline SymbolTable& airlineSymbols() { static SymbolTable table; return table; }
+inline SymbolTable& flightSymbols() { static SymbolTable table; return table; }
+
 // Airport class to represent an airport entity
 class Airport {
 private:
-    string name;           // Name of the airport (e.g., Delhi International)
+    uint32_t id;           // Interned name (dense airport ID)
+    string_view name;      // Name of the airport (e.g., Delhi International), owned by airportSymbols()
     string location;       // Location of the airport (e.g., Delhi)
-    vector<string> flights; // List of flight numbers associated with the airport
+    vector<uint32_t> flights; // IDs of the flights associated with the airport
 
 public:
     // Constructor
-    Airport(string name, string location) : name(name), location(location) {}
+    Airport(string_view name, string location)
+        : id(airportSymbols().intern(name)), name(airportSymbols().name(id)), location(location) {}
 
     // Getters
-    string getName() const { return name; }
+    uint32_t getId() const { return id; }
+    string_view getName() const { return name; }
     string getLocation() const { return location; }
-    const vector<string>& getFlights() const { return flights; }
+    const vector<uint32_t>& getFlights() const { return flights; }
 
-    // Add a flight to the airport
-    void addFlight(const string& flightNumber) {
-        flights.push_back(flightNumber);
+    // Add a flight to the airport (consecutive schedules of one flight are recorded once)
+    void addFlight(uint32_t flightId) {
+        if (flights.empty() || flights.back() != flightId) flights.push_back(flightId);
     }
 };
 
@@ -62,47 +147,199 @@ public:
     SeatClass getClassType() const { return classType; }
 };
 
-// FlightSeat class extends Seat to include pricing and booking status
+// FlightSeat class extends Seat to include pricing and its position in the flight
+// (booking status lives per Schedule, see SeatInventory)
 class FlightSeat : public Seat {
 private:
     double price;          // Price of the seat for a specific schedule
-    SeatStatus status;     // Booking status (Open or Booked)
+    int slot;              // Index of the seat within its SeatClass (assigned by Flight::addSeat)
 
 public:
     // Constructor
     FlightSeat(string seatNumber, SeatClass classType, double price) 
-        : Seat(seatNumber, classType), price(price), status(SeatStatus::OPEN) {}
+        : Seat(seatNumber, classType), price(price), slot(-1) {}
 
     // Getters
     double getPrice() const { return price; }
-    SeatStatus getStatus() const { return status; }
+    int getSlot() const { return slot; }
+
+    // Set the per-class slot (called once when the seat is added to a flight)
+    void setSlot(int newSlot) { slot = newSlot; }
+};
+
+// SeatInventory holds the booking state of one Schedule as atomic bitmaps,
+// one bitmap per SeatClass. Bit = 1 means booked (or slot not populated).
+// Booking is a single compare-and-swap on the seat's word, and "first free
+// seat in class X" is a find-first-zero over the words, so concurrent
+// bookings need no lock and can never double book.
+// The slot -> seat tables are owned by the Flight and shared by all of its
+// schedules. Seats must be added before booking starts; only book/release
+// are thread-safe.
+class SeatInventory {
+public:
+    static constexpr int NUM_CLASSES = 2; // ECONOMY, BUSINESS
+
+private:
+    static constexpr uint64_t ALL_BOOKED = ~0ULL;
+
+    const vector<FlightSeat*>* slotSeats;  // Per class: slot -> seat (owned by the Flight)
+    size_t wordCount;                      // Words per class (64 slots per word)
+    unique_ptr<atomic<uint64_t>[]> words;  // NUM_CLASSES bitmaps back to back
+
+    static int classIndex(SeatClass classType) { return static_cast<int>(classType); }
+
+    atomic<uint64_t>* bitmap(SeatClass classType) const {
+        return words.get() + classIndex(classType) * wordCount;
+    }
+
+public:
+    // Constructor: room for 'capacity' slots per class, all unavailable until opened
+    SeatInventory(int capacity, const vector<FlightSeat*>* slotSeats)
+        : slotSeats(slotSeats), wordCount((static_cast<size_t>(capacity) + 63) / 64),
+          words(new atomic<uint64_t>[NUM_CLASSES * wordCount]) {
+        for (size_t w = 0; w < NUM_CLASSES * wordCount; ++w) words[w].store(ALL_BOOKED, memory_order_relaxed);
+    }
+
+    // Make a seat bookable on this schedule (setup time only)
+    void addSeat(const FlightSeat* seat) {
+        size_t slot = static_cast<size_t>(seat->getSlot());
+        if (slot >= wordCount * 64) return;
+        bitmap(seat->getClassType())[slot / 64].fetch_and(~(1ULL << (slot % 64)), memory_order_release);
+    }
+
+    // Make slots [0, count) of a class bookable in one pass (setup time only)
+    void openSlots(SeatClass classType, size_t count) {
+        atomic<uint64_t>* classWords = bitmap(classType);
+        count = min(count, wordCount * 64);
+        for (size_t w = 0; w < wordCount; ++w) {
+            size_t first = w * 64;
+            uint64_t word = ALL_BOOKED;
+            if (count >= first + 64) word = 0;
+            else if (count > first) word = ALL_BOOKED << (count - first);
+            classWords[w].store(word, memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_release);
+    }
+
+    // Book a specific seat; false if it was already booked or is not a seat of
+    // this schedule (one CAS, retried only when a neighbouring seat in the same
+    // word changed concurrently)
+    bool book(const FlightSeat* seat) {
+        const vector<FlightSeat*>& seats = slotSeats[classIndex(seat->getClassType())];
+        size_t slot = static_cast<size_t>(seat->getSlot());
+        if (slot >= seats.size() || seats[slot] != seat) return false;
+        atomic<uint64_t>& word = bitmap(seat->getClassType())[slot / 64];
+        uint64_t mask = 1ULL << (slot % 64);
+        uint64_t current = word.load(memory_order_relaxed);
+        while (!(current & mask)) {
+            if (word.compare_exchange_weak(current, current | mask,
+                                           memory_order_acq_rel, memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Book the first free seat of a class; nullptr if the class is sold out
+    FlightSeat* bookFirstFree(SeatClass classType) {
+        atomic<uint64_t>* classWords = bitmap(classType);
+        for (size_t w = 0; w < wordCount; ++w) {
+            uint64_t current = classWords[w].load(memory_order_relaxed);
+            while (current != ALL_BOOKED) {
+                int bit = __builtin_ctzll(~current); // first zero bit = first free slot
+                if (classWords[w].compare_exchange_weak(current, current | (1ULL << bit),
+                                                        memory_order_acq_rel, memory_order_relaxed)) {
+                    return slotSeats[classIndex(classType)][w * 64 + bit];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // Release a booked seat (e.g. cancellation); false if it was not booked
+    bool release(const FlightSeat* seat) {
+        const vector<FlightSeat*>& seats = slotSeats[classIndex(seat->getClassType())];
+        size_t slot = static_cast<size_t>(seat->getSlot());
+        if (slot >= seats.size() || seats[slot] != seat) return false;
+        uint64_t mask = 1ULL << (slot % 64);
+        return bitmap(seat->getClassType())[slot / 64].fetch_and(~mask, memory_order_acq_rel) & mask;
+    }
+
+    // Status of a seat on this schedule
+    SeatStatus getStatus(const FlightSeat* seat) const {
+        size_t slot = static_cast<size_t>(seat->getSlot());
+        if (slot >= wordCount * 64) return SeatStatus::BOOKED;
+        uint64_t word = bitmap(seat->getClassType())[slot / 64].load(memory_order_acquire);
+        return (word >> (slot % 64)) & 1 ? SeatStatus::BOOKED : SeatStatus::OPEN;
+    }
+
+    // Raw bitmap access for snapshots and recovery
+    size_t getWordCount() const { return wordCount; }
+    uint64_t loadWord(SeatClass classType, size_t w) const {
+        return bitmap(classType)[w].load(memory_order_acquire);
+    }
+    void storeWord(SeatClass classType, size_t w, uint64_t word) {
+        bitmap(classType)[w].store(word, memory_order_release);
+    }
 
-    // Set booking status
-    void setStatus(SeatStatus newStatus) { status = newStatus; }
+    // Number of open seats in a class (popcount over the inverted words)
+    int countOpen(SeatClass classType) const {
+        const atomic<uint64_t>* classWords = bitmap(classType);
+        int open = 0;
+        for (size_t w = 0; w < wordCount; ++w) {
+            open += __builtin_popcountll(~classWords[w].load(memory_order_relaxed));
+        }
+        return open;
+    }
 };
 
 // Airline class to represent an airline entity
 class Airline {
 private:
-    string name;           // Name of the airline (e.g., Indigo)
-    vector<string> flights; // List of flight numbers operated by the airline
+    uint32_t id;           // Interned name (dense airline ID)
+    string_view name;      // Name of the airline (e.g., Indigo), owned by airlineSymbols()
+    vector<uint32_t> flights; // IDs of the flights operated by the airline
 
 public:
     // Constructor
-    Airline(string name) : name(name) {}
+    Airline(string_view name) : id(airlineSymbols().intern(name)), name(airlineSymbols().name(id)) {}
 
     // Getters
-    string getName() const { return name; }
-    const vector<string>& getFlights() const { return flights; }
+    uint32_t getId() const { return id; }
+    string_view getName() const { return name; }
+    const vector<uint32_t>& getFlights() const { return flights; }
 
     // Add a flight to the airline
-    void addFlight(const string& flightNumber) {
-        flights.push_back(flightNumber);
+    void addFlight(uint32_t flightId) {
+        flights.push_back(flightId);
     }
 };
 
 // Forward declaration of Flight class to resolve circular dependency
 class Flight;
+class Schedule;
+
+// RouteIndex maps an interned (source, destination) airport pair to its schedules,
+// kept sorted by departure time, so a search is a hash lookup + lower_bound
+// instead of a scan over every flight and schedule.
+class RouteIndex {
+private:
+    unordered_map<uint64_t, vector<Schedule*>> routes;     // (srcId, dstId) -> schedules sorted by startTime
+
+    static uint64_t routeKey(uint32_t sourceId, uint32_t destinationId) {
+        return (static_cast<uint64_t>(sourceId) << 32) | destinationId;
+    }
+
+public:
+    // Insert a schedule, keeping the route's list sorted by startTime (defined after Schedule)
+    void addSchedule(Schedule* schedule);
+
+    // All schedules on a route sorted by startTime (nullptr if the route is unknown)
+    const vector<Schedule*>* getRoute(uint32_t sourceId, uint32_t destinationId) const {
+        auto it = routes.find(routeKey(sourceId, destinationId));
+        return it == routes.end() ? nullptr : &it->second;
+    }
+};
 
 // Schedule class to represent a flight schedule
 class Schedule {
@@ -113,13 +350,12 @@ private:
     time_t startTime;      // Departure timestamp
     time_t endTime;        // Arrival timestamp
     ScheduleStatus status; // Status of the schedule (OnTime, Delayed, Canceled)
+    SeatInventory seatInventory; // Per-schedule seat booking state
 
 public:
-    // Constructor
+    // Constructor (defined after Flight: the inventory is sized from the flight's capacity)
     Schedule(Flight* flight, Airport* source, Airport* destination, 
-             time_t startTime, time_t endTime, ScheduleStatus status) 
-        : flight(flight), source(source), destination(destination), 
-          startTime(startTime), endTime(endTime), status(status) {}
+             time_t startTime, time_t endTime, ScheduleStatus status);
 
     // Getters
     Flight* getFlight() const { return flight; }
@@ -128,47 +364,86 @@ public:
     time_t getStartTime() const { return startTime; }
     time_t getEndTime() const { return endTime; }
     ScheduleStatus getStatus() const { return status; }
+    SeatInventory& getSeatInventory() { return seatInventory; }
+    const SeatInventory& getSeatInventory() const { return seatInventory; }
 };
 
 // Flight class to represent a flight entity
 class Flight {
 private:
-    string flightNumber;   // Unique flight number (e.g., IND101)
+    uint32_t id;           // Interned flight number (dense flight ID)
+    string_view flightNumber; // Unique flight number (e.g., IND101), owned by flightSymbols()
     Airline* airline;      // Reference to the associated Airline
     int seatCapacity;      // Total number of seats
     vector<FlightSeat*> seats; // List of seats in the flight
     vector<Schedule*> schedules; // List of schedules for the flight
+    vector<FlightSeat*> seatsByClass[SeatInventory::NUM_CLASSES]; // Per SeatClass: slot -> seat
+    RouteIndex* routeIndex = nullptr; // Index to keep in sync (set when added to the system)
 
 public:
     // Constructor
-    Flight(string flightNumber, Airline* airline, int seatCapacity) 
-        : flightNumber(flightNumber), airline(airline), seatCapacity(seatCapacity) {
-        airline->addFlight(flightNumber); // Register flight with airline
+    Flight(string_view flightNumber, Airline* airline, int seatCapacity) 
+        : id(flightSymbols().intern(flightNumber)), flightNumber(flightSymbols().name(id)),
+          airline(airline), seatCapacity(seatCapacity) {
+        airline->addFlight(id); // Register flight with airline
     }
 
     // Getters
-    string getFlightNumber() const { return flightNumber; }
+    uint32_t getId() const { return id; }
+    string_view getFlightNumber() const { return flightNumber; }
     Airline* getAirline() const { return airline; }
     int getSeatCapacity() const { return seatCapacity; }
     const vector<FlightSeat*>& getSeats() const { return seats; }
     const vector<Schedule*>& getSchedules() const { return schedules; }
+    const vector<FlightSeat*>* getSeatsByClass() const { return seatsByClass; }
 
     // Add a seat to the flight
     void addSeat(FlightSeat* seat) {
         if (seats.size() < static_cast<size_t>(seatCapacity)) {
+            vector<FlightSeat*>& classSeats = seatsByClass[static_cast<int>(seat->getClassType())];
+            seat->setSlot(static_cast<int>(classSeats.size()));
+            classSeats.push_back(seat);
             seats.push_back(seat);
+            // Make the seat bookable on every existing schedule
+            for (Schedule* schedule : schedules) schedule->getSeatInventory().addSeat(seat);
         }
     }
 
     // Add a schedule to the flight
     void addSchedule(Schedule* schedule) {
         schedules.push_back(schedule);
+        // Every seat of the flight is bookable on the new schedule
+        for (int c = 0; c < SeatInventory::NUM_CLASSES; ++c) {
+            schedule->getSeatInventory().openSlots(static_cast<SeatClass>(c), seatsByClass[c].size());
+        }
         // Register flight with source and destination airports
-        schedule->getSource()->addFlight(flightNumber);
-        schedule->getDestination()->addFlight(flightNumber);
+        schedule->getSource()->addFlight(id);
+        schedule->getDestination()->addFlight(id);
+        // Keep the route index correct for schedules added after registration
+        if (routeIndex) routeIndex->addSchedule(schedule);
+    }
+
+    // Attach the system's route index and index all existing schedules
+    void attachRouteIndex(RouteIndex* index) {
+        routeIndex = index;
+        for (Schedule* schedule : schedules) routeIndex->addSchedule(schedule);
     }
 };
 
+Schedule::Schedule(Flight* flight, Airport* source, Airport* destination,
+                   time_t startTime, time_t endTime, ScheduleStatus status)
+    : flight(flight), source(source), destination(destination),
+      startTime(startTime), endTime(endTime), status(status),
+      seatInventory(flight->getSeatCapacity(), flight->getSeatsByClass()) {}
+
+void RouteIndex::addSchedule(Schedule* schedule) {
+    vector<Schedule*>& route = routes[routeKey(schedule->getSource()->getId(), schedule->getDestination()->getId())];
+    // upper_bound keeps equal departure times in insertion order
+    auto pos = upper_bound(route.begin(), route.end(), schedule->getStartTime(),
+                           [](time_t t, const Schedule* s) { return t < s->getStartTime(); });
+    route.insert(pos, schedule);
+}
+
 // User class to represent a customer
 class User {
 private:
@@ -195,138 +470,2341 @@ private:
     Flight* flight;        // Reference to the booked flight
     Schedule* schedule;    // Reference to the booked schedule
     User* user;            // Reference to the user
+    FlightSeat* seat;      // Booked seat (nullptr if not tracked)
     string pnrNumber;      // Unique PNR number
-    string source;         // Source location
-    string destination;    // Destination location
+    string_view source;    // Source airport name, owned by airportSymbols()
+    string_view destination; // Destination airport name, owned by airportSymbols()
     time_t travelDate;     // Travel date
 
 public:
     // Constructor
     BookingDetails(Flight* flight, Schedule* schedule, User* user, string pnrNumber, 
-                   string source, string destination, time_t travelDate) 
-        : flight(flight), schedule(schedule), user(user), pnrNumber(pnrNumber), 
+                   string_view source, string_view destination, time_t travelDate, FlightSeat* seat = nullptr) 
+        : flight(flight), schedule(schedule), user(user), seat(seat), pnrNumber(pnrNumber), 
           source(source), destination(destination), travelDate(travelDate) {}
 
     // Getters
     Flight* getFlight() const { return flight; }
     Schedule* getSchedule() const { return schedule; }
     User* getUser() const { return user; }
+    FlightSeat* getSeat() const { return seat; }
     string getPnrNumber() const { return pnrNumber; }
-    string getSource() const { return source; }
-    string getDestination() const { return destination; }
+    string_view getSource() const { return source; }
+    string_view getDestination() const { return destination; }
     time_t getTravelDate() const { return travelDate; }
 };
 
-// FlightBookingSystem class to manage the core functionality
-class FlightBookingSystem {
+// Modular inverse of 'a' modulo 'm' (extended Euclid), used to undo the PNR scramble
+constexpr uint64_t modInverse(uint64_t a, uint64_t m) {
+    int64_t t = 0, newT = 1;
+    int64_t r = static_cast<int64_t>(m), newR = static_cast<int64_t>(a);
+    while (newR != 0) {
+        int64_t q = r / newR;
+        int64_t tmp = t - q * newT; t = newT; newT = tmp;
+        tmp = r - q * newR; r = newR; newR = tmp;
+    }
+    return static_cast<uint64_t>(t < 0 ? t + static_cast<int64_t>(m) : t);
+}
+
+// PnrGenerator hands out unique, fixed-width base-36 PNRs (e.g. "K3Z9QA").
+// Each thread reserves a block of sequence numbers with one fetch_add and then
+// generates PNRs from its block with no cross-core synchronization and no heap
+// allocation. The sequence is scrambled by a multiply-add that is a bijection
+// modulo 36^6, so PNRs don't look sequential but can be decoded back to the
+// sequence number for an O(1) reverse lookup.
+class PnrGenerator {
+public:
+    static constexpr int PNR_LENGTH = 6;
+    static constexpr uint64_t PNR_SPACE = 2176782336ULL; // 36^6 distinct PNRs
+
 private:
-    vector<User*> users;   // List of registered users
-    vector<Flight*> flights; // List of available flights
+    static constexpr uint64_t BLOCK_SIZE = 1024;           // Sequence numbers reserved per thread at a time
+    static constexpr uint64_t SCRAMBLE = 1500450271ULL;    // Coprime with 36^6 (odd, not a multiple of 3)
+    static constexpr uint64_t OFFSET = 1234567890ULL;      // Keeps the first PNRs away from "000000"
+
+    static constexpr uint64_t UNSCRAMBLE = modInverse(SCRAMBLE, PNR_SPACE);
+    static_assert(SCRAMBLE * UNSCRAMBLE % PNR_SPACE == 1, "scramble must be invertible");
+
+    // Per-thread block of reserved sequence numbers
+    struct ThreadBlock {
+        uint64_t owner = 0; // Generator instance the block belongs to
+        uint64_t next = 0;
+        uint64_t end = 0;
+    };
+
+    static atomic<uint64_t>& instanceCounter() {
+        static atomic<uint64_t> counter{0};
+        return counter;
+    }
+
+    const uint64_t instanceId;      // Distinguishes generators sharing a thread
+    atomic<uint64_t> nextBlock{0};  // Start of the next unreserved block
+
+    static int digitValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+        return -1;
+    }
 
 public:
     // Constructor
-    FlightBookingSystem() {}
+    PnrGenerator() : instanceId(++instanceCounter()) {}
 
-    // Add a user to the system
-    void addUser(User* user) {
-        users.push_back(user);
+    // Reserve the next sequence number; false once all 36^6 PNRs are used
+    bool nextSequence(uint64_t& sequence) {
+        thread_local ThreadBlock block;
+        if (block.owner != instanceId || block.next == block.end) {
+            uint64_t start = nextBlock.fetch_add(BLOCK_SIZE, memory_order_relaxed);
+            if (start >= PNR_SPACE) return false;
+            block.owner = instanceId;
+            block.next = start;
+            block.end = min(start + BLOCK_SIZE, PNR_SPACE);
+        }
+        sequence = block.next++;
+        return true;
     }
 
-    // Add a flight to the system
-    void addFlight(Flight* flight) {
-        flights.push_back(flight);
+    // Never hand out sequence numbers <= 'sequence' (used after recovery)
+    void reserveThrough(uint64_t sequence) {
+        uint64_t needed = (sequence / BLOCK_SIZE + 1) * BLOCK_SIZE;
+        uint64_t current = nextBlock.load(memory_order_relaxed);
+        while (current < needed && !nextBlock.compare_exchange_weak(current, needed, memory_order_relaxed)) {}
     }
 
-    // Search for flights based on source, destination, and date
-    vector<Schedule*> getFlightDetails(string source, string destination, time_t date) {
-        vector<Schedule*> result;
-        // Iterate through all flights and their schedules
+    // Write the PNR for a sequence number into 'out' (exactly PNR_LENGTH chars, no terminator)
+    static void encode(uint64_t sequence, char* out) {
+        static const char DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        uint64_t value = (sequence * SCRAMBLE + OFFSET) % PNR_SPACE;
+        for (int i = PNR_LENGTH - 1; i >= 0; --i) {
+            out[i] = DIGITS[value % 36];
+            value /= 36;
+        }
+    }
+
+    // Recover the sequence number from a PNR; false if it is not a well-formed PNR
+    static bool decode(const string& pnr, uint64_t& sequence) {
+        if (pnr.size() != static_cast<size_t>(PNR_LENGTH)) return false;
+        uint64_t value = 0;
+        for (char c : pnr) {
+            int digit = digitValue(c);
+            if (digit < 0) return false;
+            value = value * 36 + static_cast<uint64_t>(digit);
+        }
+        sequence = (value + PNR_SPACE - OFFSET) % PNR_SPACE * UNSCRAMBLE % PNR_SPACE;
+        return true;
+    }
+};
+
+// PnrRegistry maps PNR sequence numbers to bookings for reverse lookup.
+// Sequence numbers are dense, so this is a two-level direct-address table
+// (directory -> chunk of slots) instead of a hash map; a chunk is allocated
+// once per CHUNK_SIZE bookings, so registering a booking is allocation-free.
+class PnrRegistry {
+private:
+    static constexpr uint64_t CHUNK_BITS = 12;
+    static constexpr uint64_t CHUNK_SIZE = 1ULL << CHUNK_BITS;
+    static constexpr uint64_t DIRECTORY_SIZE = (PnrGenerator::PNR_SPACE + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    struct Chunk {
+        atomic<BookingDetails*> slots[CHUNK_SIZE];
+        Chunk() { for (auto& slot : slots) slot.store(nullptr, memory_order_relaxed); }
+    };
+
+    // One chunk pointer per CHUNK_SIZE sequence numbers (about 4 MB for the whole
+    // PNR space), zeroed up front; only the chunks are allocated on demand
+    unique_ptr<atomic<Chunk*>[]> directory;
+
+    // Chunk holding a sequence number, allocated on first use
+    Chunk* getChunk(uint64_t sequence, bool create) {
+        atomic<Chunk*>& entry = directory[sequence >> CHUNK_BITS];
+        Chunk* chunk = entry.load(memory_order_acquire);
+        if (chunk || !create) return chunk;
+        Chunk* fresh = new Chunk();
+        if (entry.compare_exchange_strong(chunk, fresh, memory_order_acq_rel, memory_order_acquire)) {
+            return fresh;
+        }
+        delete fresh; // Another thread installed the chunk first
+        return chunk;
+    }
+
+public:
+    // Constructor
+    PnrRegistry() : directory(new atomic<Chunk*>[DIRECTORY_SIZE]()) {}
+
+    // Destructor: free the allocated chunks (bookings themselves are not owned)
+    ~PnrRegistry() {
+        for (uint64_t i = 0; i < DIRECTORY_SIZE; ++i) delete directory[i].load(memory_order_relaxed);
+    }
+
+    PnrRegistry(const PnrRegistry&) = delete;
+    PnrRegistry& operator=(const PnrRegistry&) = delete;
+
+    // Record the booking issued for a sequence number
+    void add(uint64_t sequence, BookingDetails* booking) {
+        getChunk(sequence, true)->slots[sequence & (CHUNK_SIZE - 1)].store(booking, memory_order_release);
+    }
+
+    // Booking for a PNR, or nullptr if the PNR was never issued
+    BookingDetails* find(const string& pnr) {
+        uint64_t sequence;
+        if (!PnrGenerator::decode(pnr, sequence)) return nullptr;
+        return find(sequence);
+    }
+
+    // Booking for a sequence number, or nullptr
+    BookingDetails* find(uint64_t sequence) {
+        if (sequence >= PnrGenerator::PNR_SPACE) return nullptr;
+        Chunk* chunk = getChunk(sequence, false);
+        if (!chunk) return nullptr;
+        return chunk->slots[sequence & (CHUNK_SIZE - 1)].load(memory_order_acquire);
+    }
+
+    // Remove a booking; false if 'booking' is no longer registered (e.g. cancelled twice)
+    bool remove(uint64_t sequence, BookingDetails* booking) {
+        Chunk* chunk = getChunk(sequence, false);
+        if (!chunk) return false;
+        return chunk->slots[sequence & (CHUNK_SIZE - 1)].compare_exchange_strong(booking, nullptr,
+                                                                                memory_order_acq_rel);
+    }
+
+    // Visit every registered booking with its sequence number
+    template <typename Visit>
+    void forEach(Visit visit) {
+        for (uint64_t c = 0; c < DIRECTORY_SIZE; ++c) {
+            Chunk* chunk = directory[c].load(memory_order_acquire);
+            if (!chunk) continue;
+            for (uint64_t i = 0; i < CHUNK_SIZE; ++i) {
+                BookingDetails* booking = chunk->slots[i].load(memory_order_acquire);
+                if (booking) visit((c << CHUNK_BITS) | i, booking);
+            }
+        }
+    }
+};
+
+// TypedArena stores objects of one type contiguously in fixed-size chunks.
+// create() is a lock-free bump of a shared index (a chunk is allocated once per
+// CHUNK_SIZE objects), pointers stay stable, and teardown frees whole chunks
+// instead of one heap block per object. Objects cannot be freed individually.
+// If a constructor throws, its slot is recorded as dead and never destroyed.
+template <typename T>
+class TypedArena {
+private:
+    static constexpr size_t CHUNK_BITS = 10;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;   // Objects per chunk
+    static constexpr size_t MAX_CHUNKS = size_t(1) << 16;           // Up to ~67M objects per type
+
+    struct Chunk {
+        alignas(T) unsigned char storage[CHUNK_SIZE * sizeof(T)];
+    };
+
+    unique_ptr<atomic<Chunk*>[]> chunks; // Zero-initialised chunk directory
+    atomic<size_t> count{0};             // Slots handed out so far (including dead ones)
+    mutex deadMutex;
+    vector<size_t> deadSlots;            // Slots whose constructor threw (rare)
+
+    // Chunk for a directory slot, allocated on first use
+    Chunk* getChunk(size_t chunkIndex) {
+        atomic<Chunk*>& entry = chunks[chunkIndex];
+        Chunk* chunk = entry.load(memory_order_acquire);
+        if (chunk) return chunk;
+        Chunk* fresh = new Chunk;
+        if (entry.compare_exchange_strong(chunk, fresh, memory_order_acq_rel, memory_order_acquire)) {
+            return fresh;
+        }
+        delete fresh; // Another thread installed the chunk first
+        return chunk;
+    }
+
+public:
+    // Constructor
+    TypedArena() : chunks(new atomic<Chunk*>[MAX_CHUNKS]()) {}
+
+    // Destructor: bulk teardown (destructors only run for non-trivial types)
+    ~TypedArena() {
+        size_t total = min(count.load(memory_order_acquire), CHUNK_SIZE * MAX_CHUNKS);
+        size_t chunkCount = (total + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        sort(deadSlots.begin(), deadSlots.end());
+        auto dead = deadSlots.begin();
+        for (size_t c = 0; c < chunkCount; ++c) {
+            Chunk* chunk = chunks[c].load(memory_order_relaxed);
+            if (!chunk) continue;
+            if (!is_trivially_destructible<T>::value) {
+                size_t inChunk = min(CHUNK_SIZE, total - c * CHUNK_SIZE);
+                for (size_t i = 0; i < inChunk; ++i) {
+                    size_t index = c * CHUNK_SIZE + i;
+                    while (dead != deadSlots.end() && *dead < index) ++dead;
+                    if (dead != deadSlots.end() && *dead == index) continue; // Never constructed
+                    reinterpret_cast<T*>(chunk->storage + i * sizeof(T))->~T();
+                }
+            }
+            delete chunk;
+        }
+    }
+
+    TypedArena(const TypedArena&) = delete;
+    TypedArena& operator=(const TypedArena&) = delete;
+
+    // Construct a new object in the arena
+    template <typename... Args>
+    T* create(Args&&... args) {
+        size_t index = count.fetch_add(1, memory_order_relaxed);
+        if (index >= CHUNK_SIZE * MAX_CHUNKS) throw bad_alloc();
+        try {
+            Chunk* chunk = getChunk(index >> CHUNK_BITS);
+            void* slot = chunk->storage + (index & (CHUNK_SIZE - 1)) * sizeof(T);
+            return new (slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            lock_guard<mutex> lock(deadMutex); // The slot stays unused; skip it at teardown
+            deadSlots.push_back(index);
+            throw;
+        }
+    }
+
+    // Number of objects created
+    size_t size() {
+        lock_guard<mutex> lock(deadMutex);
+        return min(count.load(memory_order_relaxed), CHUNK_SIZE * MAX_CHUNKS) - deadSlots.size();
+    }
+};
+
+// DomainArena is the arena-backed allocation mode for the whole domain model:
+// one TypedArena per entity type, so each type lives in contiguous chunks and
+// the full object graph (e.g. a day's schedule) is released in one teardown.
+// Usage: arena.create<Flight>(...) instead of new Flight(...); the entity
+// classes and FlightBookingSystem keep the same public API.
+class DomainArena {
+private:
+    TypedArena<Airline> airlines;
+    TypedArena<Airport> airports;
+    TypedArena<Flight> flights;
+    TypedArena<FlightSeat> seats;
+    TypedArena<Schedule> schedules;
+    TypedArena<User> users;
+    TypedArena<BookingDetails> bookings;
+
+    // Pick the pool for a type (overloads on a typed null pointer)
+    TypedArena<Airline>& pool(Airline*) { return airlines; }
+    TypedArena<Airport>& pool(Airport*) { return airports; }
+    TypedArena<Flight>& pool(Flight*) { return flights; }
+    TypedArena<FlightSeat>& pool(FlightSeat*) { return seats; }
+    TypedArena<Schedule>& pool(Schedule*) { return schedules; }
+    TypedArena<User>& pool(User*) { return users; }
+    TypedArena<BookingDetails>& pool(BookingDetails*) { return bookings; }
+
+public:
+    // Construct a domain object of type T in its pool
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return pool(static_cast<T*>(nullptr)).create(std::forward<Args>(args)...);
+    }
+};
+
+// How connecting itineraries are ranked
+enum class ItineraryRank {
+    ARRIVAL_TIME,
+    PRICE
+};
+
+// Itinerary is a direct or connecting trip: 1 to 3 schedules (up to 2 stops)
+struct Itinerary {
+    vector<Schedule*> legs;
+    time_t departure = 0;
+    time_t arrival = 0;
+    double price = 0; // Sum of the cheapest seat price of each leg
+};
+
+// ItineraryIndex answers multi-leg searches with the Connection Scan Algorithm
+// (CSA). At build time every ON_TIME schedule becomes a connection with its
+// cheapest fare and airport IDs renumbered densely over the airports the index
+// actually uses, and all connections are sorted by departure. A query scans
+// forward from the first connection departing after the requested time and
+// keeps, per (airport, legs used), a bag of partial itineraries. A connection
+// extends every label at its origin that arrived at least minConnectionTime
+// before departure. A new label is dropped only if K labels already in its bag
+// arrive no later and cost no more; any trip through it has K trips at least
+// as early and as cheap, so the top K is exact for both rankings. When ranking
+// by arrival, the scan stops as soon as a connection departs after the K-th
+// best arrival found so far; otherwise it stops at the search horizon.
+// Schedules added after build() are not seen until the index is rebuilt.
+class ItineraryIndex {
+private:
+    static constexpr int MAX_LEGS = 3; // Direct, 1-stop, 2-stop
+
+    struct Connection {
+        uint32_t from, to;
+        time_t departure, arrival;
+        double price;
+        Schedule* schedule;
+    };
+
+    // Partial itinerary ending at 'connection' (prev = previous label, -1 for the first leg)
+    struct Label {
+        time_t arrival;
+        double price;
+        int legs;
+        int connection;
+        int prev;
+    };
+
+    // Query scratch, one per thread and reused across searches
+    struct Scratch {
+        vector<vector<int>> bags;                // Label indices per (airport, legs)
+        vector<size_t> usedBags;                 // Bags to empty before the next query
+        vector<Label> labels;
+        vector<int> found;                       // Labels that reached the destination
+    };
+
+    static constexpr uint32_t NO_AIRPORT = UINT32_MAX;
+
+    vector<Connection> connections;              // Sorted by departure, local airport IDs
+    vector<uint32_t> localIds;                   // Airport ID -> local ID (NO_AIRPORT if unused)
+    size_t airportCount = 0;                     // Local airport IDs (bag table size)
+    time_t minConnectionTime;
+
+    // True if 'a' ranks before 'b'
+    static bool better(const Label& a, const Label& b, ItineraryRank rank) {
+        if (rank == ItineraryRank::PRICE && a.price != b.price) return a.price < b.price;
+        if (a.arrival != b.arrival) return a.arrival < b.arrival;
+        return a.price < b.price;
+    }
+
+    // True unless 'topK' labels in the bag arrive no later and cost no more than 'label'
+    static bool admits(const vector<int>& bag, size_t topK, const Label& label, const vector<Label>& labels) {
+        size_t dominators = 0;
+        for (int other : bag) {
+            const Label& o = labels[other];
+            if (o.arrival <= label.arrival && o.price <= label.price && ++dominators >= topK) return false;
+        }
+        return true;
+    }
+
+    // True if the partial itinerary ending in 'label' already visits 'airport'
+    bool visits(const vector<Label>& labels, int label, uint32_t airport) const {
+        for (; label >= 0; label = labels[label].prev) {
+            const Connection& c = connections[labels[label].connection];
+            if (c.from == airport || c.to == airport) return true;
+        }
+        return false;
+    }
+
+public:
+    // Constructor
+    explicit ItineraryIndex(time_t minConnectionTime = 45 * 60) : minConnectionTime(minConnectionTime) {}
+
+    // Precompute the departure-sorted connections of all flights
+    void build(const vector<Flight*>& flights) {
+        connections.clear();
+        localIds.assign(airportSymbols().size(), NO_AIRPORT);
+        airportCount = 0;
+        auto localId = [&](uint32_t id) {
+            if (localIds[id] == NO_AIRPORT) localIds[id] = static_cast<uint32_t>(airportCount++);
+            return localIds[id];
+        };
         for (Flight* flight : flights) {
+            double cheapest = 0;
+            for (size_t i = 0; i < flight->getSeats().size(); ++i) {
+                double price = flight->getSeats()[i]->getPrice();
+                if (i == 0 || price < cheapest) cheapest = price;
+            }
             for (Schedule* schedule : flight->getSchedules()) {
-                // Check if the schedule matches the source, destination, and date
-                if (schedule->getSource()->getName() == source &&
-                    schedule->getDestination()->getName() == destination &&
-                    schedule->getStartTime() >= date &&
-                    schedule->getStatus() == ScheduleStatus::ON_TIME) {
-                    result.push_back(schedule);
+                if (schedule->getStatus() != ScheduleStatus::ON_TIME) continue;
+                connections.push_back({localId(schedule->getSource()->getId()),
+                                       localId(schedule->getDestination()->getId()),
+                                       schedule->getStartTime(), schedule->getEndTime(), cheapest, schedule});
+            }
+        }
+        sort(connections.begin(), connections.end(),
+             [](const Connection& a, const Connection& b) { return a.departure < b.departure; });
+    }
+
+    void setMinConnectionTime(time_t seconds) { minConnectionTime = seconds; }
+
+    // Top-K itineraries from 'source' to 'destination' departing at or after 'date'
+    // and within 'horizon' seconds of it, with at most 'maxStops' (0-2) stops
+    vector<Itinerary> search(uint32_t sourceId, uint32_t destinationId, time_t date,
+                             size_t topK, ItineraryRank rank, int maxStops, time_t horizon) const {
+        vector<Itinerary> result;
+        // Airports interned after build(), or without connections, have no itineraries
+        if (topK == 0 || sourceId >= localIds.size() || destinationId >= localIds.size()) return result;
+        if (sourceId == destinationId) return result;
+        sourceId = localIds[sourceId];
+        destinationId = localIds[destinationId];
+        if (sourceId == NO_AIRPORT || destinationId == NO_AIRPORT) return result;
+        int maxLegs = min(MAX_LEGS, max(0, maxStops) + 1);
+
+        thread_local Scratch scratch;
+        for (size_t bag : scratch.usedBags) scratch.bags[bag].clear();
+        scratch.usedBags.clear();
+        if (scratch.bags.size() < airportCount * MAX_LEGS) scratch.bags.resize(airportCount * MAX_LEGS);
+        vector<vector<int>>& bags = scratch.bags;
+        vector<Label>& labels = scratch.labels;
+        vector<int>& found = scratch.found;
+        labels.clear();
+        found.clear();
+        time_t cutoff = date + horizon;
+
+        auto first = lower_bound(connections.begin(), connections.end(), date,
+                                 [](const Connection& c, time_t t) { return c.departure < t; });
+        for (auto it = first; it != connections.end() && it->departure <= cutoff; ++it) {
+            const Connection& c = *it;
+            if (c.to == sourceId) continue;
+            int connection = static_cast<int>(it - connections.begin());
+
+            // Extend a label with this connection (prev = -1 starts at the source)
+            auto extend = [&](int prev, double prevPrice, int prevLegs) {
+                Label label{c.arrival, prevPrice + c.price, prevLegs + 1, connection, prev};
+                if (c.to == destinationId) {
+                    labels.push_back(label);
+                    found.push_back(static_cast<int>(labels.size()) - 1);
+                    return;
+                }
+                if (label.legs >= maxLegs) return;
+                if (prev >= 0 && visits(labels, prev, c.to)) return;
+                size_t bag = c.to * MAX_LEGS + label.legs;
+                if (!admits(bags[bag], topK, label, labels)) return;
+                if (bags[bag].empty()) scratch.usedBags.push_back(bag);
+                labels.push_back(label);
+                bags[bag].push_back(static_cast<int>(labels.size()) - 1);
+            };
+            if (c.from == sourceId) extend(-1, 0, 0);
+            for (int legs = 1; legs < maxLegs; ++legs) {
+                size_t bag = c.from * MAX_LEGS + legs;
+                for (size_t i = 0; i < bags[bag].size(); ++i) {
+                    int prev = bags[bag][i];
+                    const Label& p = labels[prev];
+                    if (p.arrival + minConnectionTime <= c.departure) extend(prev, p.price, p.legs);
                 }
             }
+
+            // Arrival ranking: nothing departing after the K-th best arrival can make the top K
+            if (rank == ItineraryRank::ARRIVAL_TIME && found.size() >= topK) {
+                nth_element(found.begin(), found.begin() + (topK - 1), found.end(),
+                            [&](int a, int b) { return better(labels[a], labels[b], rank); });
+                found.resize(topK);
+                time_t kthArrival = 0;
+                for (int f : found) kthArrival = max(kthArrival, labels[f].arrival);
+                cutoff = min(cutoff, kthArrival);
+            }
+        }
+
+        sort(found.begin(), found.end(), [&](int a, int b) { return better(labels[a], labels[b], rank); });
+        if (found.size() > topK) found.resize(topK);
+        for (int f : found) {
+            Itinerary itinerary;
+            itinerary.arrival = labels[f].arrival;
+            itinerary.price = labels[f].price;
+            for (int label = f; label >= 0; label = labels[label].prev) {
+                itinerary.legs.push_back(connections[labels[label].connection].schedule);
+            }
+            reverse(itinerary.legs.begin(), itinerary.legs.end());
+            itinerary.departure = itinerary.legs.front()->getStartTime();
+            result.push_back(move(itinerary));
         }
         return result;
     }
+};
+
+// ConfirmationPipeline sends booking confirmations off the booking thread.
+// Booking threads push the booking into a bounded MPSC ring buffer (one CAS,
+// no lock, no formatting); a background worker drains it in batches, formats
+// each batch into one buffer and writes it with a single fwrite + fflush.
+// An idle worker blocks on a condition variable; producers only take its
+// mutex when the worker has announced that it is going to sleep.
+// When the ring is full, submit() yields until the worker frees a slot and
+// counts the stall, so overload shows up in the counters instead of memory.
+class ConfirmationPipeline {
+public:
+    // Snapshot of the pipeline counters
+    struct Stats {
+        uint64_t submitted = 0;   // Confirmations accepted into the queue
+        uint64_t delivered = 0;   // Confirmations written to the sink
+        uint64_t batches = 0;     // fwrite/fflush calls
+        uint64_t fullStalls = 0;  // Times a producer found the queue full (backpressure)
+        uint64_t maxDepth = 0;    // Largest queue depth seen by the worker
+    };
+
+private:
+    static constexpr size_t BATCH_SIZE = 256;
+
+    // Ring cell: 'sequence' says whether the cell is free for position p (== p)
+    // or holds the item for position p (== p + 1)
+    struct Cell {
+        atomic<size_t> sequence;
+        BookingDetails* booking;
+    };
+
+    const size_t mask;
+    unique_ptr<Cell[]> cells;
+    alignas(64) atomic<size_t> enqueuePos{0};  // Shared by producers
+    alignas(64) size_t dequeuePos = 0;         // Owned by the worker
+    alignas(64) atomic<uint64_t> submitted{0};
+    atomic<uint64_t> delivered{0};
+    atomic<uint64_t> batches{0};
+    atomic<uint64_t> fullStalls{0};
+    atomic<uint64_t> maxDepth{0};
+    atomic<bool> stopping{false};
+    atomic<bool> sleeping{false};  // Worker found the ring empty and is about to wait
+    mutex wakeMutex;
+    condition_variable wakeCv;
+    FILE* sink;
+    thread worker;
+
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t power = 1;
+        while (power < n) power <<= 1;
+        return power;
+    }
 
-    // Book a flight for a user
-    BookingDetails* bookFlight(Flight* flight, Schedule* schedule, User* user, FlightSeat* seat) {
-        // Check if the seat is available
-        if (seat->getStatus() == SeatStatus::OPEN) {
-            // Update seat status to booked
-            seat->setStatus(SeatStatus::BOOKED);
-            // Generate a unique PNR (simplified for demo)
-            string pnr = "PNR" + to_string(rand() % 1000000);
-            // Create booking details
-            return new BookingDetails(flight, schedule, user, pnr, 
-                                     schedule->getSource()->getName(), 
-                                     schedule->getDestination()->getName(), 
-                                     schedule->getStartTime());
+    // Non-blocking enqueue; false if the ring is full
+    bool tryPush(BookingDetails* booking) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.booking = booking;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Full: the cell still holds an item from one lap ago
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
         }
-        return nullptr; // Booking failed (seat not available)
     }
 
-    // Confirm booking and send notification (simulated)
-    void confirmBooking(BookingDetails* booking) {
-        // Simulate sending a notification (e.g., email)
-        cout << "Booking confirmed! PNR: " << booking->getPnrNumber() 
-             << ", User: " << booking->getUser()->getName() 
-             << ", Flight: " << booking->getFlight()->getFlightNumber() 
-             << ", From: " << booking->getSource() 
-             << " To: " << booking->getDestination() << endl;
-        // In a real system, this would call the Notification Module
+    // Wake the worker if it is asleep (call after publishing an item or 'stopping')
+    void wake() {
+        // Pairs with the fence in run(): either the worker sees the new state
+        // before it waits, or this thread sees 'sleeping' and wakes it
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!sleeping.load(memory_order_relaxed)) return;
+        {
+            lock_guard<mutex> lock(wakeMutex);
+            sleeping.store(false, memory_order_relaxed);
+        }
+        wakeCv.notify_one();
     }
-};
 
-// Main function to demonstrate the system
-int main() {
-    // Create an airline
-    Airline* indigo = new Airline("Indigo");
+    // True if the next cell holds an item (worker only)
+    bool hasItem() const {
+        return cells[dequeuePos & mask].sequence.load(memory_order_acquire) == dequeuePos + 1;
+    }
 
-    // Create airports
-    Airport* delhi = new Airport("Delhi International", "Delhi");
-    Airport* bangalore = new Airport("Bangalore International", "Bangalore");
+    // Single-consumer dequeue; false if the ring is empty
+    bool tryPop(BookingDetails*& booking) {
+        Cell& cell = cells[dequeuePos & mask];
+        if (cell.sequence.load(memory_order_acquire) != dequeuePos + 1) return false;
+        booking = cell.booking;
+        cell.sequence.store(dequeuePos + mask + 1, memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
 
-    // Create a flight
-    Flight* flight101 = new Flight("IND101", indigo, 150);
+    // Append one confirmation line (same text the synchronous version printed)
+    static void format(const BookingDetails* booking, string& out) {
+        out += "Booking confirmed! PNR: ";
+        out += booking->getPnrNumber();
+        out += ", User: ";
+        out += booking->getUser()->getName();
+        out += ", Flight: ";
+        out += booking->getFlight()->getFlightNumber();
+        out += ", From: ";
+        out += booking->getSource();
+        out += " To: ";
+        out += booking->getDestination();
+        out += '\n';
+    }
 
-    // Create seats
-    FlightSeat* seat1 = new FlightSeat("15F", SeatClass::ECONOMY, 7000.0);
-    flight101->addSeat(seat1);
+    // Worker loop: drain up to BATCH_SIZE items, format, write once, repeat
+    void run() {
+        string buffer;
+        buffer.reserve(BATCH_SIZE * 128);
+        while (true) {
+            size_t depth = enqueuePos.load(memory_order_relaxed) - dequeuePos;
+            if (depth > maxDepth.load(memory_order_relaxed)) maxDepth.store(depth, memory_order_relaxed);
 
-    // Create a schedule
-    time_t now = time(nullptr);
-    Schedule* schedule1 = new Schedule(flight101, delhi, bangalore, now, now + 7200, ScheduleStatus::ON_TIME);
-    flight101->addSchedule(schedule1);
+            size_t count = 0;
+            BookingDetails* booking;
+            while (count < BATCH_SIZE && tryPop(booking)) {
+                format(booking, buffer);
+                ++count;
+            }
+            if (count > 0) {
+                fwrite(buffer.data(), 1, buffer.size(), sink);
+                fflush(sink);
+                buffer.clear();
+                batches.fetch_add(1, memory_order_relaxed);
+                delivered.fetch_add(count, memory_order_release);
+                continue;
+            }
+            // Queue empty: exit once stopping (everything submitted has been drained)
+            if (stopping.load(memory_order_acquire) &&
+                delivered.load(memory_order_relaxed) == submitted.load(memory_order_acquire)) {
+                return;
+            }
+            // Announce the sleep, then look once more so a push that missed the flag is not lost
+            unique_lock<mutex> lock(wakeMutex);
+            sleeping.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (!hasItem() && !stopping.load(memory_order_relaxed)) {
+                wakeCv.wait(lock, [&] { return !sleeping.load(memory_order_relaxed); });
+            }
+            sleeping.store(false, memory_order_relaxed);
+        }
+    }
 
-    // Create a user
-    User* user1 = new User("John Doe", "john@example.com", "1990-01-01", "Male");
+public:
+    // Constructor: starts the worker (capacity is rounded up to a power of two)
+    explicit ConfirmationPipeline(size_t capacity = 4096, FILE* sink = stdout)
+        : mask(roundUpToPowerOfTwo(max<size_t>(capacity, 2)) - 1),
+          cells(new Cell[mask + 1]), sink(sink) {
+        for (size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, memory_order_relaxed);
+        worker = thread(&ConfirmationPipeline::run, this);
+    }
 
-    // Create the flight booking system
-    FlightBookingSystem* system = new FlightBookingSystem();
-    system->addUser(user1);
-    system->addFlight(flight101);
+    // Destructor: drains everything still queued, then stops the worker
+    ~ConfirmationPipeline() {
+        stopping.store(true, memory_order_release);
+        wake();
+        worker.join();
+    }
 
-    // Search for flights
-    vector<Schedule*> availableFlights = system->getFlightDetails("Delhi International", "Bangalore International", now);
-    if (!availableFlights.empty()) {
-        cout << "Found " << availableFlights.size() << " flights!" << endl;
-        // Book the first available flight
-        BookingDetails* booking = system->bookFlight(flight101, availableFlights[0], user1, seat1);
-        if (booking) {
-            system->confirmBooking(booking);
-        } else {
-            cout << "Booking failed: Seat not available" << endl;
+    ConfirmationPipeline(const ConfirmationPipeline&) = delete;
+    ConfirmationPipeline& operator=(const ConfirmationPipeline&) = delete;
+
+    // Queue a confirmation; yields while the queue is full (backpressure)
+    void submit(BookingDetails* booking) {
+        if (!tryPush(booking)) {
+            fullStalls.fetch_add(1, memory_order_relaxed);
+            while (!tryPush(booking)) this_thread::yield();
         }
-    } else {
-        cout << "No flights found!" << endl;
+        submitted.fetch_add(1, memory_order_release);
+        wake();
+    }
+
+    // Wait until every confirmation submitted so far has been written
+    void flush() {
+        uint64_t target = submitted.load(memory_order_acquire);
+        while (delivered.load(memory_order_acquire) < target) this_thread::yield();
+    }
+
+    Stats getStats() const {
+        Stats stats;
+        stats.submitted = submitted.load(memory_order_relaxed);
+        stats.delivered = delivered.load(memory_order_relaxed);
+        stats.batches = batches.load(memory_order_relaxed);
+        stats.fullStalls = fullStalls.load(memory_order_relaxed);
+        stats.maxDepth = maxDepth.load(memory_order_relaxed);
+        return stats;
+    }
+};
+
+// CRC-32 (IEEE) used to detect torn or corrupt log records
+inline uint32_t crc32(const void* data, size_t length, uint32_t crc = 0) {
+    static const auto table = [] {
+        array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Kinds of seat state change recorded in the write-ahead log
+enum class WalRecordType : uint8_t {
+    BOOK = 1,
+    RELEASE = 2
+};
+
+// Fixed part of a log record; the flight number follows it. A schedule is
+// identified by (flight number, start time) and a seat by (class, slot), so
+// records stay valid when the same schedule feed is loaded after a restart.
+struct WalRecordHeader {
+    uint32_t crc;            // CRC-32 of the record with this field set to 0
+    uint16_t length;         // Total record length in bytes
+    uint8_t type;            // WalRecordType
+    uint8_t seatClass;
+    uint64_t lsn;            // Log sequence number (1, 2, 3, ...)
+    uint64_t pnrSequence;
+    int64_t startTime;
+    uint32_t slot;
+    uint32_t userIndex;      // Registration order of the user (UINT32_MAX = unknown)
+};
+static_assert(sizeof(WalRecordHeader) == 40, "WalRecordHeader layout is part of the log format");
+
+// WriteAheadLog appends records to segment files (wal-<first LSN>.log) with
+// group commit: appenders copy their record into a shared buffer under a
+// short lock, and one flusher thread writes everything buffered so far and
+// calls fdatasync once for the whole batch. Threads that need durability
+// wait until the durable LSN passes their record. rotate() closes the
+// current segment so a checkpoint can drop it once a snapshot covers it.
+class WriteAheadLog {
+private:
+    string directory;
+    int fd = -1;
+    mutex ioMutex;              // Serialises writes/fsync/rotation (taken before appendMutex)
+    mutex appendMutex;          // Protects the buffer and LSN counters
+    condition_variable flusherCv;
+    condition_variable durableCv;
+    string active;              // Records waiting for the next batch
+    uint64_t lastLsn = 0;       // Last LSN handed out
+    uint64_t durableLsn = 0;    // Every record <= this is on disk
+    uint64_t batches = 0;
+    bool stopping = false;
+    bool failed = false;
+    thread flusher;
+
+    static string segmentName(uint64_t firstLsn) {
+        char name[40];
+        snprintf(name, sizeof(name), "wal-%020llu.log", static_cast<unsigned long long>(firstLsn));
+        return name;
+    }
+
+    bool openSegment(uint64_t firstLsn) {
+        string path = directory + "/" + segmentName(firstLsn);
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        return fd >= 0;
+    }
+
+    bool writeAll(const string& data) {
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        return data.empty() || fdatasync(fd) == 0;
+    }
+
+    // Mark everything up to 'lsn' durable (or the log failed) and wake waiters
+    void publish(uint64_t lsn, bool ok) {
+        {
+            lock_guard<mutex> lock(appendMutex);
+            if (ok) durableLsn = max(durableLsn, lsn);
+            else failed = true;
+            ++batches;
+        }
+        durableCv.notify_all();
+    }
+
+    void run() {
+        string batch;
+        while (true) {
+            {
+                unique_lock<mutex> lock(appendMutex);
+                flusherCv.wait(lock, [&] { return !active.empty() || stopping; });
+                if (active.empty() && stopping) return;
+            }
+            lock_guard<mutex> io(ioMutex);
+            uint64_t batchLsn;
+            {
+                lock_guard<mutex> lock(appendMutex);
+                swap(active, batch);
+                batchLsn = lastLsn;
+            }
+            if (batch.empty()) continue; // rotate() already wrote it
+            bool ok = writeAll(batch);   // One write + one fdatasync for the whole batch
+            batch.clear();
+            publish(batchLsn, ok);
+        }
+    }
+
+public:
+    WriteAheadLog() = default;
+    ~WriteAheadLog() { close(); }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Start a new segment whose first record gets 'firstLsn'
+    bool open(const string& dir, uint64_t firstLsn) {
+        directory = dir;
+        lastLsn = durableLsn = firstLsn - 1;
+        if (!openSegment(firstLsn)) return false;
+        flusher = thread(&WriteAheadLog::run, this);
+        return true;
+    }
+
+    // Flush what is buffered and stop the flusher
+    void close() {
+        if (!flusher.joinable()) return;
+        {
+            lock_guard<mutex> lock(appendMutex);
+            stopping = true;
+        }
+        flusherCv.notify_one();
+        flusher.join();
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    // Append a record (header.lsn, crc and length are filled in); returns its LSN
+    uint64_t append(WalRecordHeader header, string_view flightNumber) {
+        char record[sizeof(WalRecordHeader) + 256];
+        size_t nameLength = min<size_t>(flightNumber.size(), 256);
+        header.length = static_cast<uint16_t>(sizeof(WalRecordHeader) + nameLength);
+        header.crc = 0;
+        uint64_t lsn;
+        {
+            lock_guard<mutex> lock(appendMutex);
+            lsn = header.lsn = ++lastLsn;
+            memcpy(record, &header, sizeof(header));
+            memcpy(record + sizeof(header), flightNumber.data(), nameLength);
+            uint32_t crc = crc32(record, header.length);
+            memcpy(record, &crc, sizeof(crc));
+            active.append(record, header.length);
+        }
+        flusherCv.notify_one();
+        return lsn;
+    }
+
+    // Block until the record with 'lsn' is on disk; false if the log failed
+    bool waitDurable(uint64_t lsn) {
+        unique_lock<mutex> lock(appendMutex);
+        durableCv.wait(lock, [&] { return durableLsn >= lsn || failed; });
+        return durableLsn >= lsn;
+    }
+
+    // Write out everything appended so far, then continue in a new segment;
+    // 'closedLsn' is the last LSN of the closed segment
+    bool rotate(uint64_t& closedLsn) {
+        lock_guard<mutex> io(ioMutex);
+        string tail;
+        {
+            lock_guard<mutex> lock(appendMutex);
+            swap(active, tail);
+            closedLsn = lastLsn;
+        }
+        bool ok = writeAll(tail);
+        ::close(fd);
+        ok = openSegment(closedLsn + 1) && ok;
+        publish(closedLsn, ok);
+        return ok;
+    }
+
+    // Delete closed segments whose records are all <= 'coveredLsn'
+    void removeSegmentsCoveredBy(uint64_t coveredLsn) {
+        vector<pair<uint64_t, string>> segments = listSegments(directory);
+        for (size_t i = 0; i + 1 < segments.size(); ++i) {
+            // A segment ends right before the next one starts
+            if (segments[i + 1].first - 1 <= coveredLsn) ::unlink(segments[i].second.c_str());
+        }
+    }
+
+    uint64_t getLastLsn() {
+        lock_guard<mutex> lock(appendMutex);
+        return lastLsn;
+    }
+
+    uint64_t getBatchCount() {
+        lock_guard<mutex> lock(appendMutex);
+        return batches;
+    }
+
+    // Segment files in a directory as (first LSN, path), oldest first
+    static vector<pair<uint64_t, string>> listSegments(const string& dir) {
+        vector<pair<uint64_t, string>> segments;
+        DIR* handle = opendir(dir.c_str());
+        if (!handle) return segments;
+        while (dirent* entry = readdir(handle)) {
+            unsigned long long firstLsn;
+            char tail[8];
+            if (sscanf(entry->d_name, "wal-%20llu.%3s", &firstLsn, tail) == 2 && strcmp(tail, "log") == 0) {
+                segments.emplace_back(firstLsn, dir + "/" + entry->d_name);
+            }
+        }
+        closedir(handle);
+        sort(segments.begin(), segments.end());
+        return segments;
+    }
+};
+
+class FlightBookingSystem;
+
+// BookingPersistence makes bookings survive a restart. Every booking and
+// cancellation is appended to the WriteAheadLog; a background thread
+// periodically checkpoints: it rotates the log, writes a compact snapshot
+// (seat bitmaps of schedules that have bookings + the active bookings)
+// tagged with the last LSN it covers, and deletes the covered segments.
+// Rotation and the in-memory copy happen while no booking or cancellation
+// is half-applied, so the snapshot matches its LSN exactly.
+// Recovery loads the snapshot and replays only the log tail after it.
+// Flights, schedules and users must be set up the same way (e.g. from the
+// same feed) before recovery, since records refer to them by key.
+class BookingPersistence {
+private:
+    FlightBookingSystem& system;
+    string directory;
+    WriteAheadLog wal;
+    bool syncCommit;                   // Wait for fsync before a booking returns
+    chrono::seconds checkpointInterval;
+    mutex checkpointMutex;             // Guards 'stopping' for the checkpoint thread
+    mutex checkpointRunMutex;          // One checkpoint at a time
+    shared_mutex changeGate;           // Shared: a seat change in progress; exclusive: a checkpoint cut
+    condition_variable checkpointCv;
+    bool stopping = false;
+    atomic<uint64_t> lastCheckpointLsn{0};
+    thread checkpointer;
+
+    struct SnapshotHeader {
+        char magic[4];           // "FBSN"
+        uint32_t version;
+        uint64_t coveredLsn;     // Log records <= this are already in the snapshot
+        uint32_t scheduleCount;
+        uint32_t bookingCount;
+    };
+
+    string snapshotPath() const { return directory + "/snapshot.bin"; }
+
+    string buildSnapshot(uint64_t coveredLsn);
+    bool writeSnapshot(const string& image);
+    bool loadSnapshot(uint64_t& coveredLsn);
+    bool replaySegments(uint64_t coveredLsn, uint64_t& lastLsn);
+    void applyRecord(const WalRecordHeader& header, string_view flightNumber);
+    void runCheckpoints();
+
+public:
+    BookingPersistence(FlightBookingSystem& system, const string& directory,
+                       bool syncCommit, chrono::seconds checkpointInterval)
+        : system(system), directory(directory), syncCommit(syncCommit),
+          checkpointInterval(checkpointInterval) {}
+
+    ~BookingPersistence();
+
+    // Recover state from the directory, then start logging
+    bool open();
+
+    // Held (shared) by a booking or cancellation from its first in-memory step
+    // until its record is appended; a checkpoint holds it exclusively while it
+    // rotates the log and copies the state, so a snapshot never has half a change
+    shared_lock<shared_mutex> lockChanges() { return shared_lock<shared_mutex>(changeGate); }
+
+    // Append a seat state change to the log; returns its LSN
+    uint64_t logChange(WalRecordType type, uint64_t pnrSequence, const BookingDetails* booking);
+
+    // Wait for the group commit of 'lsn' if syncCommit is set; false if the log failed
+    bool waitDurable(uint64_t lsn) { return !syncCommit || wal.waitDurable(lsn); }
+
+    // Rotate the log, write a snapshot and drop the covered segments
+    bool checkpoint();
+
+    uint64_t getFsyncCount() { return wal.getBatchCount(); }
+};
+
+// FlightBookingSystem class to manage the core functionality
+class FlightBookingSystem {
+    friend class BookingPersistence;
+
+private:
+    vector<User*> users;   // List of registered users
+    vector<Flight*> flights; // List of available flights
+    unordered_map<const User*, uint32_t> userIndex;   // User -> registration order (log key)
+    unordered_map<uint32_t, Flight*> flightsByNumber; // Flight ID -> flight (recovery lookups)
+    RouteIndex routeIndex; // (source, destination) -> schedules sorted by departure
+    PnrGenerator pnrGenerator; // Unique PNRs from per-thread sequence blocks
+    PnrRegistry pnrRegistry;   // PNR -> booking reverse lookup
+    ItineraryIndex itineraryIndex; // Departure-sorted connections for multi-leg search
+    ConfirmationPipeline confirmations; // Async, batched booking notifications
+    unique_ptr<BookingPersistence> persistence; // WAL + snapshots (nullptr -> in-memory only)
+    DomainArena* arena;        // Where bookings are allocated (nullptr -> heap)
+
+public:
+    // Constructor (pass an arena to allocate bookings from it)
+    explicit FlightBookingSystem(DomainArena* arena = nullptr) : arena(arena) {}
+
+    // Add a user to the system
+    void addUser(User* user) {
+        userIndex.emplace(user, static_cast<uint32_t>(users.size()));
+        users.push_back(user);
+    }
+
+    // Add a flight to the system
+    void addFlight(Flight* flight) {
+        flights.push_back(flight);
+        flightsByNumber.emplace(flight->getId(), flight);
+        flight->attachRouteIndex(&routeIndex);
+    }
+
+    // Search for flights based on source, destination, and date
+    // Hash lookup on the route + lower_bound on departure time; results are sorted by startTime
+    vector<Schedule*> getFlightDetails(string_view source, string_view destination, time_t date) {
+        uint32_t sourceId, destinationId;
+        if (!airportSymbols().find(source, sourceId) ||
+            !airportSymbols().find(destination, destinationId)) {
+            return {}; // Unknown airport -> no schedules
+        }
+        return getFlightDetails(sourceId, destinationId, date);
+    }
+
+    // Same search by interned airport IDs (no string hashing on the hot path)
+    vector<Schedule*> getFlightDetails(uint32_t sourceId, uint32_t destinationId, time_t date) {
+        vector<Schedule*> result;
+        const vector<Schedule*>* route = routeIndex.getRoute(sourceId, destinationId);
+        if (!route) return result;
+
+        // Jump to the first schedule departing at or after 'date'
+        auto it = lower_bound(route->begin(), route->end(), date,
+                              [](const Schedule* s, time_t t) { return s->getStartTime() < t; });
+        for (; it != route->end(); ++it) {
+            if ((*it)->getStatus() == ScheduleStatus::ON_TIME) {
+                result.push_back(*it);
+            }
+        }
+        return result;
+    }
+
+    // Precompute the connection index used by searchItineraries (call after loading schedules)
+    void buildItineraryIndex() {
+        itineraryIndex.build(flights);
+    }
+
+    // Minimum time between arriving on one leg and departing on the next
+    void setMinConnectionTime(time_t seconds) {
+        itineraryIndex.setMinConnectionTime(seconds);
+    }
+
+    // Search direct, 1-stop and 2-stop itineraries; top-K by arrival time or price
+    vector<Itinerary> searchItineraries(string_view source, string_view destination, time_t date,
+                                        size_t topK = 5, ItineraryRank rank = ItineraryRank::ARRIVAL_TIME,
+                                        int maxStops = 2, time_t horizon = 24 * 3600) const {
+        uint32_t sourceId, destinationId;
+        if (!airportSymbols().find(source, sourceId) ||
+            !airportSymbols().find(destination, destinationId)) {
+            return {}; // Unknown airport -> no itineraries
+        }
+        return itineraryIndex.search(sourceId, destinationId, date, topK, rank, maxStops, horizon);
+    }
+
+    // Book a flight for a user
+    BookingDetails* bookFlight(Flight* flight, Schedule* schedule, User* user, FlightSeat* seat) {
+        shared_lock<shared_mutex> changes = lockChanges();
+        // Atomically claim the seat on this schedule (fails if already booked)
+        if (!schedule->getSeatInventory().book(seat)) {
+            return nullptr; // Booking failed (seat not available)
+        }
+        return createBooking(flight, schedule, user, seat, changes);
+    }
+
+    // Book the first open seat of a class on a schedule
+    BookingDetails* bookFirstAvailable(Schedule* schedule, User* user, SeatClass classType) {
+        shared_lock<shared_mutex> changes = lockChanges();
+        FlightSeat* seat = schedule->getSeatInventory().bookFirstFree(classType);
+        if (!seat) {
+            return nullptr; // Class sold out
+        }
+        return createBooking(schedule->getFlight(), schedule, user, seat, changes);
+    }
+
+    // Cancel a booking and free its seat; false if it was already cancelled
+    bool cancelBooking(BookingDetails* booking) {
+        shared_lock<shared_mutex> changes = lockChanges();
+        uint64_t sequence;
+        if (!booking->getSeat() || !PnrGenerator::decode(booking->getPnrNumber(), sequence) ||
+            !pnrRegistry.remove(sequence, booking)) {
+            return false;
+        }
+        // Log before freeing the seat: once it is free another thread may book it,
+        // and that BOOK must come after this RELEASE in the log
+        uint64_t lsn = persistence ? persistence->logChange(WalRecordType::RELEASE, sequence, booking) : 0;
+        booking->getSchedule()->getSeatInventory().release(booking->getSeat());
+        changes.unlock();
+        if (persistence) persistence->waitDurable(lsn);
+        return true;
+    }
+
+    // Make bookings durable in 'directory': recovers the previous state (snapshot +
+    // log tail), then logs every change. Call after flights, schedules and users
+    // are set up. With syncCommit a booking returns only once its log batch is fsynced.
+    bool enableDurability(const string& directory, bool syncCommit = true,
+                          chrono::seconds checkpointInterval = chrono::seconds(60)) {
+        persistence.reset(new BookingPersistence(*this, directory, syncCommit, checkpointInterval));
+        if (!persistence->open()) {
+            persistence.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // Snapshot now and truncate the log (also done periodically in the background)
+    bool checkpoint() {
+        return persistence && persistence->checkpoint();
+    }
+
+    // Reverse lookup of a booking by its PNR (nullptr if unknown)
+    BookingDetails* findBooking(const string& pnr) {
+        return pnrRegistry.find(pnr);
+    }
+
+private:
+    // Checkpoint gate of the persistence layer (not locked when durability is off)
+    shared_lock<shared_mutex> lockChanges() {
+        return persistence ? persistence->lockChanges() : shared_lock<shared_mutex>();
+    }
+
+    // Build booking details once the seat has been claimed (releases the seat on failure);
+    // 'changes' is released once the booking is logged, before waiting for the fsync
+    BookingDetails* createBooking(Flight* flight, Schedule* schedule, User* user, FlightSeat* seat,
+                                  shared_lock<shared_mutex>& changes) {
+        // Generate a unique PNR; 6 chars fit the string's small buffer, so no heap allocation
+        uint64_t sequence;
+        if (!pnrGenerator.nextSequence(sequence)) {
+            schedule->getSeatInventory().release(seat); // PNRs exhausted
+            return nullptr;
+        }
+        BookingDetails* booking = newBooking(sequence, flight, schedule, user, seat);
+        pnrRegistry.add(sequence, booking);
+        if (!persistence) return booking;
+        uint64_t lsn = persistence->logChange(WalRecordType::BOOK, sequence, booking);
+        changes.unlock();
+        // Durable before it is acknowledged; undo if the log cannot be written
+        if (!persistence->waitDurable(lsn)) {
+            changes.lock();
+            pnrRegistry.remove(sequence, booking);
+            schedule->getSeatInventory().release(seat);
+            return nullptr;
+        }
+        return booking;
+    }
+
+    BookingDetails* newBooking(uint64_t sequence, Flight* flight, Schedule* schedule, User* user, FlightSeat* seat) {
+        char pnr[PnrGenerator::PNR_LENGTH];
+        PnrGenerator::encode(sequence, pnr);
+        string pnrNumber(pnr, PnrGenerator::PNR_LENGTH);
+        string_view source = schedule->getSource()->getName();
+        string_view destination = schedule->getDestination()->getName();
+        return arena
+            ? arena->create<BookingDetails>(flight, schedule, user, pnrNumber, source, destination, schedule->getStartTime(), seat)
+            : new BookingDetails(flight, schedule, user, pnrNumber, source, destination, schedule->getStartTime(), seat);
+    }
+
+    // Recovery helpers (used by BookingPersistence)
+    void restoreBooking(uint64_t sequence, Schedule* schedule, User* user, FlightSeat* seat) {
+        pnrRegistry.add(sequence, newBooking(sequence, schedule->getFlight(), schedule, user, seat));
+        pnrGenerator.reserveThrough(sequence);
+    }
+
+    uint32_t getUserIndex(const User* user) const {
+        auto it = userIndex.find(user);
+        return it == userIndex.end() ? UINT32_MAX : it->second;
+    }
+
+    User* getUserByIndex(uint32_t index) const {
+        return index < users.size() ? users[index] : nullptr;
+    }
+
+    Schedule* findSchedule(string_view flightNumber, time_t startTime) const {
+        uint32_t flightId;
+        if (!flightSymbols().find(flightNumber, flightId)) return nullptr;
+        auto it = flightsByNumber.find(flightId);
+        if (it == flightsByNumber.end()) return nullptr;
+        for (Schedule* schedule : it->second->getSchedules()) {
+            if (schedule->getStartTime() == startTime) return schedule;
+        }
+        return nullptr;
+    }
+
+    static FlightSeat* findSeat(Flight* flight, uint8_t seatClass, uint32_t slot) {
+        if (seatClass >= SeatInventory::NUM_CLASSES) return nullptr;
+        const vector<FlightSeat*>& seats = flight->getSeatsByClass()[seatClass];
+        return slot < seats.size() ? seats[slot] : nullptr;
+    }
+
+public:
+
+    // Confirm booking and send notification (simulated)
+    // Only enqueues: formatting and I/O happen on the pipeline's worker thread
+    void confirmBooking(BookingDetails* booking) {
+        confirmations.submit(booking);
+        // In a real system, the worker would call the Notification Module
+    }
+
+    // Block until all queued confirmations have been sent
+    void flushConfirmations() {
+        confirmations.flush();
+    }
+
+    ConfirmationPipeline::Stats getConfirmationStats() const {
+        return confirmations.getStats();
+    }
+};
+
+// ScheduleRow is one parsed row of a schedule feed. All text fields are views
+// into the memory-mapped file, so parsing creates no per-line strings.
+struct ScheduleRow {
+    string_view airline, flightNumber;
+    string_view source, sourceLocation;
+    string_view destination, destinationLocation;
+    int seatCapacity = 0, economySeats = 0, businessSeats = 0;
+    time_t startTime = 0, endTime = 0;
+    double economyPrice = 0, businessPrice = 0;
+};
+
+// Counters reported by a bulk load
+struct LoadStats {
+    size_t rows = 0;        // Rows turned into schedules
+    size_t skippedRows = 0; // Malformed or out-of-range rows
+    size_t airlines = 0, airports = 0, flights = 0, seats = 0;
+};
+
+// MappedFile maps a whole file read-only into memory (RAII)
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+
+public:
+    // Constructor: map the file (isOpen() is false on failure)
+    explicit MappedFile(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = static_cast<const char*>(mapped);
+                length = static_cast<size_t>(info.st_size);
+                madvise(mapped, length, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd); // The mapping stays valid after the descriptor is closed
+    }
+
+    ~MappedFile() {
+        if (data) munmap(const_cast<char*>(data), length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+    const char* begin() const { return data; }
+    size_t size() const { return length; }
+};
+
+// ScheduleLoader bulk-loads an airline schedule feed into the booking system.
+//
+// CSV format, one schedule per line ('#' lines are comments):
+//   airline,flight,capacity,source,sourceLocation,destination,destinationLocation,
+//   startTime,endTime,economySeats,businessSeats,economyPrice,businessPrice
+//
+// Binary format: BinaryHeader, then 'stringCount' strings (uint16 length + bytes),
+// then 'rowCount' fixed-size BinaryRow records whose text fields are string IDs.
+//
+// The file is memory-mapped and split into one chunk per thread; each thread
+// parses its chunk into ScheduleRows (string_views into the mapping). A single
+// build pass then creates each Airline/Airport/Flight (with its FlightSeats)
+// the first time it is seen, plus one Schedule per row, all in the arena.
+// Every load creates its own entities; it does not merge with earlier loads.
+// Rows are skipped (counted in skippedRows) unless 0 < capacity <= MAX_SEAT_CAPACITY,
+// the seat counts are non-negative with at least one seat and no more than
+// the capacity, and every class that has seats has a price in (0, MAX_SEAT_PRICE].
+class ScheduleLoader {
+public:
+    struct BinaryHeader {
+        char magic[4];         // "FLSB"
+        uint32_t version;      // BINARY_VERSION
+        uint32_t stringCount;
+        uint32_t rowCount;
+    };
+
+    struct BinaryRow {
+        uint32_t airline, flightNumber;
+        uint32_t source, sourceLocation;
+        uint32_t destination, destinationLocation;
+        uint32_t seatCapacity, economySeats, businessSeats;
+        uint32_t reserved;     // Keeps the 64-bit fields aligned
+        int64_t startTime, endTime;
+        double economyPrice, businessPrice;
+    };
+    static_assert(sizeof(BinaryRow) == 72, "BinaryRow layout is part of the file format");
+
+    static constexpr uint32_t BINARY_VERSION = 1;
+
+private:
+    static constexpr int CSV_FIELDS = 13;
+    static constexpr int SEATS_PER_ROW = 6; // Seat letters A-F
+    static constexpr int MAX_SEAT_CAPACITY = 1000;   // Above the largest airliner
+    static constexpr double MAX_SEAT_PRICE = 1e7;
+
+    FlightBookingSystem& system;
+    DomainArena& arena;
+    unsigned threadCount;
+
+    // Parse a number from a field; false if the whole field is not a number
+    template <typename T>
+    static bool parseNumber(string_view field, T& value) {
+        auto result = from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == errc() && result.ptr == field.data() + field.size();
+    }
+
+    // Numeric fields within the limits above (keeps bad feeds from sizing huge seat maps)
+    static bool validRow(const ScheduleRow& row) {
+        auto validPrice = [](int seats, double price) { return seats == 0 || (price > 0 && price <= MAX_SEAT_PRICE); };
+        return row.seatCapacity > 0 && row.seatCapacity <= MAX_SEAT_CAPACITY &&
+               row.economySeats >= 0 && row.businessSeats >= 0 &&
+               row.economySeats + row.businessSeats > 0 &&
+               row.economySeats + row.businessSeats <= row.seatCapacity &&
+               validPrice(row.economySeats, row.economyPrice) && validPrice(row.businessSeats, row.businessPrice);
+    }
+
+    // Parse one CSV line (without the newline) into a row
+    static bool parseCsvLine(string_view line, ScheduleRow& row) {
+        string_view fields[CSV_FIELDS];
+        int count = 0;
+        size_t start = 0;
+        while (count < CSV_FIELDS) {
+            size_t comma = line.find(',', start);
+            fields[count++] = line.substr(start, comma == string_view::npos ? string_view::npos : comma - start);
+            if (comma == string_view::npos) break;
+            start = comma + 1;
+        }
+        if (count != CSV_FIELDS) return false;
+        int64_t startTime = 0, endTime = 0;
+        row.airline = fields[0];
+        row.flightNumber = fields[1];
+        row.source = fields[3];
+        row.sourceLocation = fields[4];
+        row.destination = fields[5];
+        row.destinationLocation = fields[6];
+        if (!parseNumber(fields[2], row.seatCapacity) ||
+            !parseNumber(fields[7], startTime) || !parseNumber(fields[8], endTime) ||
+            !parseNumber(fields[9], row.economySeats) || !parseNumber(fields[10], row.businessSeats) ||
+            !parseNumber(fields[11], row.economyPrice) || !parseNumber(fields[12], row.businessPrice)) {
+            return false;
+        }
+        row.startTime = static_cast<time_t>(startTime);
+        row.endTime = static_cast<time_t>(endTime);
+        return !row.airline.empty() && !row.flightNumber.empty() &&
+               !row.source.empty() && !row.destination.empty() && validRow(row);
+    }
+
+    // Parse CSV lines in [begin, end) into 'rows'
+    static void parseCsvChunk(const char* begin, const char* end, vector<ScheduleRow>& rows, size_t& skipped) {
+        while (begin < end) {
+            const char* newline = static_cast<const char*>(memchr(begin, '\n', static_cast<size_t>(end - begin)));
+            const char* lineEnd = newline ? newline : end;
+            string_view line(begin, static_cast<size_t>(lineEnd - begin));
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty() && line.front() != '#') {
+                ScheduleRow row;
+                if (parseCsvLine(line, row)) rows.push_back(row);
+                else ++skipped;
+            }
+            begin = lineEnd + 1;
+        }
+    }
+
+    // Run 'work(thread, begin, end)' over [0, total) split across the loader's threads
+    template <typename Work>
+    void parallelFor(size_t total, Work work) {
+        unsigned threads = static_cast<unsigned>(max<size_t>(1, min<size_t>(threadCount, total)));
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            size_t begin = total * t / threads, end = total * (t + 1) / threads;
+            workers.emplace_back([&work, t, begin, end] { work(t, begin, end); });
+        }
+        for (thread& worker : workers) worker.join();
+    }
+
+    // Concatenate per-thread results (keeps file order)
+    static vector<ScheduleRow> mergeRows(vector<vector<ScheduleRow>>& parts) {
+        size_t total = 0;
+        for (const auto& part : parts) total += part.size();
+        vector<ScheduleRow> rows;
+        rows.reserve(total);
+        for (auto& part : parts) {
+            rows.insert(rows.end(), part.begin(), part.end());
+            vector<ScheduleRow>().swap(part);
+        }
+        return rows;
+    }
+
+    // Look up an entity by name, creating it on first sight
+    template <typename T, typename Create>
+    static T* findOrCreate(unordered_map<string_view, T*>& byName, string_view name, Create create) {
+        auto it = byName.find(name);
+        if (it != byName.end()) return it->second;
+        T* entity = create();
+        byName.emplace(name, entity);
+        return entity;
+    }
+
+    // Single build pass: rows -> domain objects, registered with the system
+    void build(vector<ScheduleRow>& rows, LoadStats& stats) {
+        // Departure order makes every route-index insert an append
+        stable_sort(rows.begin(), rows.end(),
+                    [](const ScheduleRow& a, const ScheduleRow& b) { return a.startTime < b.startTime; });
+
+        unordered_map<string_view, Airline*> airlines;
+        unordered_map<string_view, Airport*> airports;
+        unordered_map<string_view, Flight*> flights;
+        for (const ScheduleRow& row : rows) {
+            Airline* airline = findOrCreate(airlines, row.airline, [&] {
+                ++stats.airlines;
+                return arena.create<Airline>(string(row.airline));
+            });
+            Airport* source = findOrCreate(airports, row.source, [&] {
+                ++stats.airports;
+                return arena.create<Airport>(string(row.source), string(row.sourceLocation));
+            });
+            Airport* destination = findOrCreate(airports, row.destination, [&] {
+                ++stats.airports;
+                return arena.create<Airport>(string(row.destination), string(row.destinationLocation));
+            });
+            Flight* flight = findOrCreate(flights, row.flightNumber, [&] {
+                ++stats.flights;
+                Flight* created = arena.create<Flight>(string(row.flightNumber), airline, row.seatCapacity);
+                addSeats(created, row, stats);
+                system.addFlight(created); // Before its schedules, so they are indexed in departure order
+                return created;
+            });
+            Schedule* schedule = arena.create<Schedule>(flight, source, destination,
+                                                        row.startTime, row.endTime, ScheduleStatus::ON_TIME);
+            flight->addSchedule(schedule);
+            ++stats.rows;
+        }
+        system.buildItineraryIndex();
+    }
+
+    // Create the flight's seats: business rows first, then economy ("1A".."1F", "2A", ...)
+    void addSeats(Flight* flight, const ScheduleRow& row, LoadStats& stats) {
+        int seatIndex = 0;
+        auto addClass = [&](int count, SeatClass classType, double price) {
+            for (int i = 0; i < count && seatIndex < flight->getSeatCapacity(); ++i, ++seatIndex) {
+                char number[16];
+                int length = snprintf(number, sizeof(number), "%d%c",
+                                      seatIndex / SEATS_PER_ROW + 1, 'A' + seatIndex % SEATS_PER_ROW);
+                flight->addSeat(arena.create<FlightSeat>(string(number, static_cast<size_t>(length)), classType, price));
+                ++stats.seats;
+            }
+        };
+        addClass(row.businessSeats, SeatClass::BUSINESS, row.businessPrice);
+        addClass(row.economySeats, SeatClass::ECONOMY, row.economyPrice);
+    }
+
+public:
+    // Constructor (threadCount = 0 -> one thread per core)
+    ScheduleLoader(FlightBookingSystem& system, DomainArena& arena, unsigned threadCount = 0)
+        : system(system), arena(arena),
+          threadCount(threadCount ? threadCount : max(1u, thread::hardware_concurrency())) {}
+
+    // Load a CSV feed; false if the file cannot be mapped
+    bool loadCsv(const string& path, LoadStats& stats) {
+        MappedFile file(path);
+        if (!file.isOpen()) return false;
+        const char* data = file.begin();
+        size_t size = file.size();
+
+        // Chunk boundaries are moved forward to the next line start
+        auto lineStart = [&](size_t offset) {
+            if (offset == 0 || offset >= size) return min(offset, size);
+            const char* newline = static_cast<const char*>(memchr(data + offset - 1, '\n', size - offset + 1));
+            return newline ? static_cast<size_t>(newline - data) + 1 : size;
+        };
+        vector<vector<ScheduleRow>> parts(threadCount);
+        vector<size_t> skipped(threadCount, 0);
+        parallelFor(size, [&](unsigned t, size_t begin, size_t end) {
+            size_t from = lineStart(begin), to = lineStart(end);
+            parts[t].reserve((to - from) / 96 + 1);
+            parseCsvChunk(data + from, data + to, parts[t], skipped[t]);
+        });
+        for (size_t count : skipped) stats.skippedRows += count;
+
+        vector<ScheduleRow> rows = mergeRows(parts);
+        build(rows, stats);
+        return true;
+    }
+
+    // Load a binary feed; false if the file cannot be mapped or is malformed
+    bool loadBinary(const string& path, LoadStats& stats) {
+        MappedFile file(path);
+        if (!file.isOpen() || file.size() < sizeof(BinaryHeader)) return false;
+        BinaryHeader header;
+        memcpy(&header, file.begin(), sizeof(header));
+        if (memcmp(header.magic, "FLSB", 4) != 0 || header.version != BINARY_VERSION) return false;
+
+        // String table: views straight into the mapping
+        vector<string_view> strings(header.stringCount);
+        size_t offset = sizeof(BinaryHeader);
+        for (uint32_t i = 0; i < header.stringCount; ++i) {
+            uint16_t length;
+            if (offset + sizeof(length) > file.size()) return false;
+            memcpy(&length, file.begin() + offset, sizeof(length));
+            offset += sizeof(length);
+            if (offset + length > file.size()) return false;
+            strings[i] = string_view(file.begin() + offset, length);
+            offset += length;
+        }
+        if (file.size() - offset < static_cast<size_t>(header.rowCount) * sizeof(BinaryRow)) return false;
+
+        const char* records = file.begin() + offset;
+        vector<vector<ScheduleRow>> parts(threadCount);
+        vector<size_t> skipped(threadCount, 0);
+        parallelFor(header.rowCount, [&](unsigned t, size_t first, size_t last) {
+            parts[t].reserve(last - first);
+            for (size_t i = first; i < last; ++i) {
+                BinaryRow record;
+                memcpy(&record, records + i * sizeof(BinaryRow), sizeof(record)); // Records may be unaligned
+                uint32_t ids[] = {record.airline, record.flightNumber, record.source,
+                                  record.sourceLocation, record.destination, record.destinationLocation};
+                uint32_t counts[] = {record.seatCapacity, record.economySeats, record.businessSeats};
+                if (any_of(begin(ids), end(ids), [&](uint32_t id) { return id >= strings.size(); }) ||
+                    any_of(begin(counts), end(counts), [](uint32_t n) { return n > MAX_SEAT_CAPACITY; })) {
+                    ++skipped[t];
+                    continue;
+                }
+                ScheduleRow row;
+                row.airline = strings[record.airline];
+                row.flightNumber = strings[record.flightNumber];
+                row.source = strings[record.source];
+                row.sourceLocation = strings[record.sourceLocation];
+                row.destination = strings[record.destination];
+                row.destinationLocation = strings[record.destinationLocation];
+                row.seatCapacity = static_cast<int>(record.seatCapacity);
+                row.economySeats = static_cast<int>(record.economySeats);
+                row.businessSeats = static_cast<int>(record.businessSeats);
+                row.startTime = static_cast<time_t>(record.startTime);
+                row.endTime = static_cast<time_t>(record.endTime);
+                row.economyPrice = record.economyPrice;
+                row.businessPrice = record.businessPrice;
+                if (!validRow(row)) {
+                    ++skipped[t];
+                    continue;
+                }
+                parts[t].push_back(row);
+            }
+        });
+        for (size_t count : skipped) stats.skippedRows += count;
+
+        vector<ScheduleRow> rows = mergeRows(parts);
+        build(rows, stats);
+        return true;
+    }
+
+    // Write rows in the binary feed format (e.g. to convert a CSV feed once)
+    static bool writeBinary(const string& path, const vector<ScheduleRow>& rows) {
+        unordered_map<string_view, uint32_t> ids;
+        vector<string_view> strings;
+        auto intern = [&](string_view text) {
+            auto it = ids.find(text);
+            if (it != ids.end()) return it->second;
+            uint32_t id = static_cast<uint32_t>(strings.size());
+            ids.emplace(text, id);
+            strings.push_back(text);
+            return id;
+        };
+        vector<BinaryRow> records;
+        records.reserve(rows.size());
+        for (const ScheduleRow& row : rows) {
+            BinaryRow record{};
+            record.airline = intern(row.airline);
+            record.flightNumber = intern(row.flightNumber);
+            record.source = intern(row.source);
+            record.sourceLocation = intern(row.sourceLocation);
+            record.destination = intern(row.destination);
+            record.destinationLocation = intern(row.destinationLocation);
+            record.seatCapacity = static_cast<uint32_t>(row.seatCapacity);
+            record.economySeats = static_cast<uint32_t>(row.economySeats);
+            record.businessSeats = static_cast<uint32_t>(row.businessSeats);
+            record.startTime = static_cast<int64_t>(row.startTime);
+            record.endTime = static_cast<int64_t>(row.endTime);
+            record.economyPrice = row.economyPrice;
+            record.businessPrice = row.businessPrice;
+            records.push_back(record);
+        }
+
+        ofstream out(path, ios::binary);
+        if (!out) return false;
+        BinaryHeader header{{'F', 'L', 'S', 'B'}, BINARY_VERSION,
+                            static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(records.size())};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (string_view text : strings) {
+            uint16_t length = static_cast<uint16_t>(min<size_t>(text.size(), UINT16_MAX));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(text.data(), length);
+        }
+        out.write(reinterpret_cast<const char*>(records.data()),
+                  static_cast<streamsize>(records.size() * sizeof(BinaryRow)));
+        return static_cast<bool>(out);
+    }
+
+    // Convert a CSV feed to the binary format (malformed rows are dropped)
+    static bool convertCsvToBinary(const string& csvPath, const string& binaryPath) {
+        MappedFile file(csvPath);
+        if (!file.isOpen()) return false;
+        vector<ScheduleRow> rows;
+        size_t skipped = 0;
+        parseCsvChunk(file.begin(), file.begin() + file.size(), rows, skipped);
+        return writeBinary(binaryPath, rows);
+    }
+};
+
+// Bounds-checked reader over a mapped snapshot or log segment
+struct ByteReader {
+    const char* cursor;
+    const char* end;
+
+    bool read(void* out, size_t length) {
+        if (static_cast<size_t>(end - cursor) < length) return false;
+        memcpy(out, cursor, length);
+        cursor += length;
+        return true;
+    }
+
+    bool readView(string_view& out, size_t length) {
+        if (static_cast<size_t>(end - cursor) < length) return false;
+        out = string_view(cursor, length);
+        cursor += length;
+        return true;
+    }
+};
+
+BookingPersistence::~BookingPersistence() {
+    {
+        lock_guard<mutex> lock(checkpointMutex);
+        stopping = true;
+    }
+    checkpointCv.notify_all();
+    if (checkpointer.joinable()) checkpointer.join();
+    wal.close();
+}
+
+bool BookingPersistence::open() {
+    mkdir(directory.c_str(), 0755); // Fine if it already exists
+    uint64_t coveredLsn = 0;
+    if (!loadSnapshot(coveredLsn)) return false;
+    uint64_t lastLsn;
+    if (!replaySegments(coveredLsn, lastLsn)) return false;
+    lastCheckpointLsn = coveredLsn;
+    // Segments after a torn record cannot be applied in order; drop them
+    for (const auto& segment : WriteAheadLog::listSegments(directory)) {
+        if (segment.first > lastLsn + 1) ::unlink(segment.second.c_str());
+    }
+    if (!wal.open(directory, lastLsn + 1)) return false;
+    checkpointer = thread(&BookingPersistence::runCheckpoints, this);
+    return true;
+}
+
+uint64_t BookingPersistence::logChange(WalRecordType type, uint64_t pnrSequence, const BookingDetails* booking) {
+    WalRecordHeader header{};
+    header.type = static_cast<uint8_t>(type);
+    header.seatClass = static_cast<uint8_t>(booking->getSeat()->getClassType());
+    header.pnrSequence = pnrSequence;
+    header.startTime = static_cast<int64_t>(booking->getSchedule()->getStartTime());
+    header.slot = static_cast<uint32_t>(booking->getSeat()->getSlot());
+    header.userIndex = system.getUserIndex(booking->getUser());
+    return wal.append(header, booking->getFlight()->getFlightNumber());
+}
+
+bool BookingPersistence::checkpoint() {
+    lock_guard<mutex> running(checkpointRunMutex);
+    uint64_t coveredLsn;
+    string image;
+    {
+        // Every record <= coveredLsn is fully applied in memory, and no later change has started
+        unique_lock<shared_mutex> changes(changeGate);
+        if (!wal.rotate(coveredLsn)) return false;
+        image = buildSnapshot(coveredLsn);
+    }
+    if (!writeSnapshot(image)) return false;
+    wal.removeSegmentsCoveredBy(coveredLsn);
+    lastCheckpointLsn = coveredLsn;
+    return true;
+}
+
+void BookingPersistence::runCheckpoints() {
+    unique_lock<mutex> lock(checkpointMutex);
+    while (!checkpointCv.wait_for(lock, checkpointInterval, [&] { return stopping; })) {
+        if (wal.getLastLsn() == lastCheckpointLsn) continue; // Nothing new to cover
+        lock.unlock();
+        checkpoint();
+        lock.lock();
+    }
+}
+
+string BookingPersistence::buildSnapshot(uint64_t coveredLsn) {
+    SnapshotHeader header{{'F', 'B', 'S', 'N'}, 1, coveredLsn, 0, 0};
+    string out(sizeof(header), '\0');
+    auto put = [&](const void* data, size_t length) { out.append(static_cast<const char*>(data), length); };
+
+    // Seat bitmaps, only for schedules that have at least one booking
+    for (Flight* flight : system.flights) {
+        string_view flightNumber = flight->getFlightNumber();
+        uint16_t nameLength = static_cast<uint16_t>(flightNumber.size());
+        for (Schedule* schedule : flight->getSchedules()) {
+            const SeatInventory& inventory = schedule->getSeatInventory();
+            bool touched = false;
+            for (int c = 0; c < SeatInventory::NUM_CLASSES; ++c) {
+                SeatClass classType = static_cast<SeatClass>(c);
+                touched |= inventory.countOpen(classType) != static_cast<int>(flight->getSeatsByClass()[c].size());
+            }
+            if (!touched) continue;
+            int64_t startTime = static_cast<int64_t>(schedule->getStartTime());
+            uint32_t wordCount = static_cast<uint32_t>(inventory.getWordCount());
+            put(&nameLength, sizeof(nameLength));
+            put(flightNumber.data(), nameLength);
+            put(&startTime, sizeof(startTime));
+            put(&wordCount, sizeof(wordCount));
+            for (int c = 0; c < SeatInventory::NUM_CLASSES; ++c) {
+                for (uint32_t w = 0; w < wordCount; ++w) {
+                    uint64_t word = inventory.loadWord(static_cast<SeatClass>(c), w);
+                    put(&word, sizeof(word));
+                }
+            }
+            ++header.scheduleCount;
+        }
+    }
+
+    // Active bookings (needed to rebuild BookingDetails and the PNR registry)
+    system.pnrRegistry.forEach([&](uint64_t sequence, BookingDetails* booking) {
+        if (!booking->getSeat()) return;
+        uint32_t userIndex = system.getUserIndex(booking->getUser());
+        uint8_t seatClass = static_cast<uint8_t>(booking->getSeat()->getClassType());
+        uint32_t slot = static_cast<uint32_t>(booking->getSeat()->getSlot());
+        string_view flightNumber = booking->getFlight()->getFlightNumber();
+        uint16_t nameLength = static_cast<uint16_t>(flightNumber.size());
+        int64_t startTime = static_cast<int64_t>(booking->getSchedule()->getStartTime());
+        put(&sequence, sizeof(sequence));
+        put(&userIndex, sizeof(userIndex));
+        put(&seatClass, sizeof(seatClass));
+        put(&slot, sizeof(slot));
+        put(&nameLength, sizeof(nameLength));
+        put(flightNumber.data(), nameLength);
+        put(&startTime, sizeof(startTime));
+        ++header.bookingCount;
+    });
+    memcpy(&out[0], &header, sizeof(header));
+    return out;
+}
+
+bool BookingPersistence::writeSnapshot(const string& image) {
+    // Write to a temporary file, fsync, then atomically replace the old snapshot
+    string tmpPath = snapshotPath() + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool ok = ::write(fd, image.data(), image.size()) == static_cast<ssize_t>(image.size()) && fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || rename(tmpPath.c_str(), snapshotPath().c_str()) != 0) return false;
+    int dirFd = ::open(directory.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd); // Make the rename durable
+        ::close(dirFd);
+    }
+    return true;
+}
+
+bool BookingPersistence::loadSnapshot(uint64_t& coveredLsn) {
+    coveredLsn = 0;
+    MappedFile file(snapshotPath());
+    if (!file.isOpen()) return true; // No snapshot yet
+    ByteReader reader{file.begin(), file.begin() + file.size()};
+    SnapshotHeader header;
+    if (!reader.read(&header, sizeof(header)) || memcmp(header.magic, "FBSN", 4) != 0 || header.version != 1) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header.scheduleCount; ++i) {
+        uint16_t nameLength;
+        string_view flightNumber;
+        int64_t startTime;
+        uint32_t wordCount;
+        if (!reader.read(&nameLength, sizeof(nameLength)) || !reader.readView(flightNumber, nameLength) ||
+            !reader.read(&startTime, sizeof(startTime)) || !reader.read(&wordCount, sizeof(wordCount))) {
+            return false;
+        }
+        Schedule* schedule = system.findSchedule(flightNumber, static_cast<time_t>(startTime));
+        bool usable = schedule && schedule->getSeatInventory().getWordCount() == wordCount;
+        for (int c = 0; c < SeatInventory::NUM_CLASSES; ++c) {
+            for (uint32_t w = 0; w < wordCount; ++w) {
+                uint64_t word;
+                if (!reader.read(&word, sizeof(word))) return false;
+                if (usable) schedule->getSeatInventory().storeWord(static_cast<SeatClass>(c), w, word);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < header.bookingCount; ++i) {
+        uint64_t sequence;
+        uint32_t userIndex, slot;
+        uint8_t seatClass;
+        uint16_t nameLength;
+        string_view flightNumber;
+        int64_t startTime;
+        if (!reader.read(&sequence, sizeof(sequence)) || !reader.read(&userIndex, sizeof(userIndex)) ||
+            !reader.read(&seatClass, sizeof(seatClass)) || !reader.read(&slot, sizeof(slot)) ||
+            !reader.read(&nameLength, sizeof(nameLength)) || !reader.readView(flightNumber, nameLength) ||
+            !reader.read(&startTime, sizeof(startTime))) {
+            return false;
+        }
+        Schedule* schedule = system.findSchedule(flightNumber, static_cast<time_t>(startTime));
+        FlightSeat* seat = schedule ? system.findSeat(schedule->getFlight(), seatClass, slot) : nullptr;
+        if (seat) system.restoreBooking(sequence, schedule, system.getUserByIndex(userIndex), seat);
+    }
+    coveredLsn = header.coveredLsn;
+    return true;
+}
+
+bool BookingPersistence::replaySegments(uint64_t coveredLsn, uint64_t& lastLsn) {
+    lastLsn = coveredLsn;
+    for (const auto& segment : WriteAheadLog::listSegments(directory)) {
+        off_t goodLength = -1; // Set when a torn or corrupt record ends the log
+        {
+            MappedFile file(segment.second);
+            if (!file.isOpen()) continue; // Empty segment
+            ByteReader reader{file.begin(), file.begin() + file.size()};
+            while (reader.cursor < reader.end) {
+                WalRecordHeader header;
+                const char* recordStart = reader.cursor;
+                string_view flightNumber;
+                if (!reader.read(&header, sizeof(header)) || header.length < sizeof(header) ||
+                    !reader.readView(flightNumber, header.length - sizeof(header))) {
+                    goodLength = recordStart - file.begin(); // Torn tail
+                    break;
+                }
+                WalRecordHeader unsignedHeader = header;
+                unsignedHeader.crc = 0;
+                uint32_t crc = crc32(&unsignedHeader, sizeof(unsignedHeader));
+                crc = crc32(recordStart + sizeof(header), flightNumber.size(), crc);
+                if (crc != header.crc) {
+                    goodLength = recordStart - file.begin(); // Corrupt record: stop at the last good one
+                    break;
+                }
+                if (header.lsn <= lastLsn) continue;  // Already covered by the snapshot
+                applyRecord(header, flightNumber);
+                lastLsn = header.lsn;
+            }
+        }
+        if (goodLength >= 0) {
+            // Cut the bad record off (durably), so the next recovery reads this
+            // segment to its end and carries on into the one opened after it
+            int fd = ::open(segment.second.c_str(), O_WRONLY);
+            if (fd < 0) return false;
+            bool ok = ftruncate(fd, goodLength) == 0 && fdatasync(fd) == 0;
+            ::close(fd);
+            return ok;
+        }
+    }
+    return true;
+}
+
+void BookingPersistence::applyRecord(const WalRecordHeader& header, string_view flightNumber) {
+    Schedule* schedule = system.findSchedule(flightNumber, static_cast<time_t>(header.startTime));
+    FlightSeat* seat = schedule ? system.findSeat(schedule->getFlight(), header.seatClass, header.slot) : nullptr;
+    if (!seat) return;
+    // Applying a record must be idempotent, so replay stays correct even where
+    // the loaded state already contains the record's effect
+    BookingDetails* existing = system.pnrRegistry.find(header.pnrSequence);
+    if (header.type == static_cast<uint8_t>(WalRecordType::BOOK)) {
+        schedule->getSeatInventory().book(seat); // Taken whether or not the snapshot has the bit
+        if (!existing) {
+            system.restoreBooking(header.pnrSequence, schedule, system.getUserByIndex(header.userIndex), seat);
+        }
+    } else if (header.type == static_cast<uint8_t>(WalRecordType::RELEASE)) {
+        // Unknown PNR: the snapshot is past this release, and the seat may be rebooked
+        if (!existing) return;
+        system.pnrRegistry.remove(header.pnrSequence, existing);
+        schedule->getSeatInventory().release(seat);
+    }
+}
+
+// FlightBenchmark measures getFlightDetails and bookFirstAvailable under load.
+//
+// Each run builds a fresh synthetic world (airports, airlines, flights with
+// seats, one schedule per flight per day, users) from a fixed seed, then
+// starts T threads that each perform a fixed number of operations. Every
+// operation is timed individually; the merged latencies give p50/p99/p999.
+// Scenarios differ only in the share of searches vs bookings.
+// Results are printed as JSON (default) or CSV so runs can be diffed over time.
+struct BenchmarkConfig {
+    int airports = 50;
+    int airlines = 10;
+    int flights = 2000;
+    int days = 30;             // Schedules per flight (one departure per day)
+    int seats = 180;           // Seats per flight (first 10% are business)
+    int users = 10000;
+    int maxThreads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    size_t opsPerThread = 200000;
+    double mixedSearchShare = 0.9; // Searches per operation in the mixed scenario
+    uint64_t seed = 42;
+    bool csv = false;
+    string outPath;            // Empty -> stdout
+};
+
+struct BenchmarkResult {
+    string scenario;
+    int threads = 0;
+    uint64_t operations = 0;
+    uint64_t searches = 0;
+    uint64_t bookings = 0;     // Successful bookings
+    uint64_t rejected = 0;     // Booking attempts on a sold-out class
+    double seconds = 0;
+    double opsPerSecond = 0;
+    double p50 = 0, p99 = 0, p999 = 0, maxLatency = 0; // Microseconds
+};
+
+class FlightBenchmark {
+private:
+    // Everything one run needs; the system is destroyed before the arena it allocates from
+    struct World {
+        DomainArena arena;
+        unique_ptr<FlightBookingSystem> system;
+        vector<Schedule*> schedules;
+        vector<User*> users;
+        vector<pair<string_view, string_view>> routes; // (source, destination) names that have flights
+        time_t firstDay = 0;
+    };
+
+    const BenchmarkConfig& config;
+
+    // Fixed epoch (2030-01-01 UTC) so every run generates the same schedules
+    static constexpr time_t BASE_DAY = 1893456000;
+
+    void buildWorld(World& world) const {
+        mt19937_64 random(config.seed);
+        world.system.reset(new FlightBookingSystem(&world.arena));
+        world.firstDay = BASE_DAY;
+
+        vector<Airport*> airports;
+        for (int i = 0; i < config.airports; ++i) {
+            string name = "Bench Airport " + to_string(i);
+            airports.push_back(world.arena.create<Airport>(name, "City " + to_string(i)));
+        }
+        vector<Airline*> airlines;
+        for (int i = 0; i < config.airlines; ++i) {
+            airlines.push_back(world.arena.create<Airline>("Bench Airline " + to_string(i)));
+        }
+        int businessSeats = config.seats / 10;
+        for (int f = 0; f < config.flights; ++f) {
+            size_t sourceIndex = random() % airports.size();
+            size_t destinationIndex = (sourceIndex + 1 + random() % (airports.size() - 1)) % airports.size();
+            Airport* source = airports[sourceIndex];
+            Airport* destination = airports[destinationIndex];
+            Flight* flight = world.arena.create<Flight>("BF" + to_string(f), airlines[f % airlines.size()], config.seats);
+            for (int s = 0; s < config.seats; ++s) {
+                bool business = s < businessSeats;
+                flight->addSeat(world.arena.create<FlightSeat>(to_string(s / 6 + 1) + char('A' + s % 6),
+                                                               business ? SeatClass::BUSINESS : SeatClass::ECONOMY,
+                                                               business ? 15000.0 : 4000.0 + random() % 4000));
+            }
+            time_t hour = static_cast<time_t>(random() % 24) * 3600;
+            for (int d = 0; d < config.days; ++d) {
+                time_t departure = BASE_DAY + static_cast<time_t>(d) * 86400 + hour;
+                Schedule* schedule = world.arena.create<Schedule>(flight, source, destination, departure,
+                                                                  departure + 7200, ScheduleStatus::ON_TIME);
+                flight->addSchedule(schedule);
+                world.schedules.push_back(schedule);
+            }
+            world.system->addFlight(flight);
+            world.routes.emplace_back(source->getName(), destination->getName());
+        }
+        for (int u = 0; u < config.users; ++u) {
+            User* user = world.arena.create<User>("Bench User " + to_string(u), "user" + to_string(u) + "@example.com",
+                                                  "1990-01-01", "Other");
+            world.system->addUser(user);
+            world.users.push_back(user);
+        }
+    }
+
+    static double percentile(const vector<uint64_t>& sorted, double q) {
+        if (sorted.empty()) return 0;
+        size_t index = min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()));
+        return sorted[index] / 1000.0;
+    }
+
+    BenchmarkResult run(const string& scenario, double searchShare, int threads) const {
+        World world;
+        buildWorld(world);
+
+        struct Worker {
+            vector<uint64_t> latencies; // Nanoseconds per operation
+            uint64_t searches = 0, bookings = 0, rejected = 0;
+        };
+        vector<Worker> workers(threads);
+        atomic<int> ready{0};
+        atomic<bool> go{false};
+        uint32_t searchThreshold = static_cast<uint32_t>(searchShare * 1000000);
+
+        auto body = [&](int index) {
+            Worker& worker = workers[index];
+            worker.latencies.reserve(config.opsPerThread);
+            mt19937_64 random(config.seed * 7919 + index);
+            ready.fetch_add(1);
+            while (!go.load(memory_order_acquire)) this_thread::yield();
+            for (size_t op = 0; op < config.opsPerThread; ++op) {
+                bool search = random() % 1000000 < searchThreshold;
+                const auto& route = world.routes[random() % world.routes.size()];
+                Schedule* schedule = world.schedules[random() % world.schedules.size()];
+                User* user = world.users[random() % world.users.size()];
+                time_t date = world.firstDay + static_cast<time_t>(random() % config.days) * 86400;
+                SeatClass classType = random() % 10 == 0 ? SeatClass::BUSINESS : SeatClass::ECONOMY;
+
+                auto start = chrono::steady_clock::now();
+                if (search) {
+                    world.system->getFlightDetails(route.first, route.second, date);
+                    ++worker.searches;
+                } else if (world.system->bookFirstAvailable(schedule, user, classType)) {
+                    ++worker.bookings;
+                } else {
+                    ++worker.rejected;
+                }
+                auto end = chrono::steady_clock::now();
+                worker.latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+            }
+        };
+
+        vector<thread> pool;
+        for (int t = 0; t < threads; ++t) pool.emplace_back(body, t);
+        while (ready.load() < threads) this_thread::yield();
+        auto start = chrono::steady_clock::now();
+        go.store(true, memory_order_release);
+        for (thread& t : pool) t.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        BenchmarkResult result;
+        result.scenario = scenario;
+        result.threads = threads;
+        vector<uint64_t> latencies;
+        latencies.reserve(config.opsPerThread * threads);
+        for (Worker& worker : workers) {
+            latencies.insert(latencies.end(), worker.latencies.begin(), worker.latencies.end());
+            result.searches += worker.searches;
+            result.bookings += worker.bookings;
+            result.rejected += worker.rejected;
+        }
+        sort(latencies.begin(), latencies.end());
+        result.operations = latencies.size();
+        result.seconds = seconds;
+        result.opsPerSecond = seconds > 0 ? latencies.size() / seconds : 0;
+        result.p50 = percentile(latencies, 0.50);
+        result.p99 = percentile(latencies, 0.99);
+        result.p999 = percentile(latencies, 0.999);
+        result.maxLatency = latencies.empty() ? 0 : latencies.back() / 1000.0;
+        return result;
+    }
+
+    void write(FILE* out, const vector<BenchmarkResult>& results) const {
+        if (config.csv) {
+            fprintf(out, "scenario,threads,operations,searches,bookings,rejected,seconds,ops_per_sec,"
+                         "p50_us,p99_us,p999_us,max_us\n");
+            for (const BenchmarkResult& r : results) {
+                fprintf(out, "%s,%d,%llu,%llu,%llu,%llu,%.6f,%.1f,%.3f,%.3f,%.3f,%.3f\n",
+                        r.scenario.c_str(), r.threads, (unsigned long long)r.operations,
+                        (unsigned long long)r.searches, (unsigned long long)r.bookings,
+                        (unsigned long long)r.rejected, r.seconds, r.opsPerSecond,
+                        r.p50, r.p99, r.p999, r.maxLatency);
+            }
+            return;
+        }
+        fprintf(out, "{\n  \"config\": {\"airports\": %d, \"airlines\": %d, \"flights\": %d, \"days\": %d, "
+                     "\"seats\": %d, \"users\": %d, \"ops_per_thread\": %zu, \"mixed_search_share\": %.3f, "
+                     "\"seed\": %llu},\n  \"results\": [\n",
+                config.airports, config.airlines, config.flights, config.days, config.seats, config.users,
+                config.opsPerThread, config.mixedSearchShare, (unsigned long long)config.seed);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& r = results[i];
+            fprintf(out, "    {\"scenario\": \"%s\", \"threads\": %d, \"operations\": %llu, \"searches\": %llu, "
+                         "\"bookings\": %llu, \"rejected\": %llu, \"seconds\": %.6f, \"ops_per_sec\": %.1f, "
+                         "\"p50_us\": %.3f, \"p99_us\": %.3f, \"p999_us\": %.3f, \"max_us\": %.3f}%s\n",
+                    r.scenario.c_str(), r.threads, (unsigned long long)r.operations,
+                    (unsigned long long)r.searches, (unsigned long long)r.bookings,
+                    (unsigned long long)r.rejected, r.seconds, r.opsPerSecond,
+                    r.p50, r.p99, r.p999, r.maxLatency, i + 1 < results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+    }
+
+public:
+    explicit FlightBenchmark(const BenchmarkConfig& config) : config(config) {}
+
+    // Run every scenario at 1, 2, 4, ... maxThreads threads and write the results
+    bool runAll() const {
+        vector<int> threadCounts;
+        for (int t = 1; t < config.maxThreads; t *= 2) threadCounts.push_back(t);
+        threadCounts.push_back(config.maxThreads);
+
+        const pair<const char*, double> scenarios[] = {
+            {"search-heavy", 1.0}, {"booking-heavy", 0.0}, {"mixed", config.mixedSearchShare}};
+        vector<BenchmarkResult> results;
+        for (const auto& scenario : scenarios) {
+            for (int threads : threadCounts) {
+                results.push_back(run(scenario.first, scenario.second, threads));
+                const BenchmarkResult& r = results.back();
+                fprintf(stderr, "%-13s threads=%-3d %12.0f ops/s  p50=%.2fus p99=%.2fus p999=%.2fus\n",
+                        r.scenario.c_str(), r.threads, r.opsPerSecond, r.p50, r.p99, r.p999);
+            }
+        }
+
+        FILE* out = config.outPath.empty() ? stdout : fopen(config.outPath.c_str(), "w");
+        if (!out) return false;
+        write(out, results);
+        return out == stdout ? fflush(out) == 0 : fclose(out) == 0;
+    }
+};
+
+// Parse "--bench" options: --airports N --airlines N --flights N --days N --seats N
+// --users N --threads N --ops N --mix SHARE --seed N --csv --out FILE
+int runBenchmark(int argc, char* argv[]) {
+    BenchmarkConfig config;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bench") continue;
+        else if (arg == "--csv") config.csv = true;
+        else if (arg == "--airports" && hasValue) config.airports = atoi(argv[++i]);
+        else if (arg == "--airlines" && hasValue) config.airlines = atoi(argv[++i]);
+        else if (arg == "--flights" && hasValue) config.flights = atoi(argv[++i]);
+        else if (arg == "--days" && hasValue) config.days = atoi(argv[++i]);
+        else if (arg == "--seats" && hasValue) config.seats = atoi(argv[++i]);
+        else if (arg == "--users" && hasValue) config.users = atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) config.maxThreads = atoi(argv[++i]);
+        else if (arg == "--ops" && hasValue) config.opsPerThread = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--mix" && hasValue) config.mixedSearchShare = atof(argv[++i]);
+        else if (arg == "--seed" && hasValue) config.seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--out" && hasValue) config.outPath = argv[++i];
+        else {
+            cerr << "Unknown benchmark option: " << arg << endl;
+            return 1;
+        }
+    }
+    if (config.airports < 2 || config.airlines < 1 || config.flights < 1 || config.days < 1 ||
+        config.seats < 1 || config.users < 1 || config.maxThreads < 1 || config.opsPerThread == 0 ||
+        config.mixedSearchShare < 0 || config.mixedSearchShare > 1) {
+        cerr << "Invalid benchmark configuration" << endl;
+        return 1;
+    }
+    if (!FlightBenchmark(config).runAll()) {
+        cerr << "Could not write benchmark results to " << config.outPath << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Main function to demonstrate the system
+// Optional: pass a schedule feed (.csv or .bin) to bulk-load it, and
+// "--data DIR" to keep bookings in DIR across runs; "--bench ..." runs the benchmark instead
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--bench") return runBenchmark(argc, argv);
+    }
+
+    string feedPath, dataDirectory;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--data" && i + 1 < argc) dataDirectory = argv[++i];
+        else feedPath = arg;
+    }
+
+    // All domain objects live in the arena and are released together at exit
+    DomainArena arena;
+
+    // Create an airline
+    Airline* indigo = arena.create<Airline>("Indigo");
+
+    // Create airports
+    Airport* delhi = arena.create<Airport>("Delhi International", "Delhi");
+    Airport* bangalore = arena.create<Airport>("Bangalore International", "Bangalore");
+
+    // Create a flight
+    Flight* flight101 = arena.create<Flight>("IND101", indigo, 150);
+
+    // Create seats
+    FlightSeat* seat1 = arena.create<FlightSeat>("15F", SeatClass::ECONOMY, 7000.0);
+    flight101->addSeat(seat1);
+
+    // Create a schedule (tomorrow 06:00 UTC, so the schedule is the same across runs of a day)
+    time_t now = time(nullptr);
+    time_t departure = (now / 86400 + 1) * 86400 + 6 * 3600;
+    Schedule* schedule1 = arena.create<Schedule>(flight101, delhi, bangalore, departure, departure + 7200, ScheduleStatus::ON_TIME);
+    flight101->addSchedule(schedule1);
+
+    // Create a user
+    User* user1 = arena.create<User>("John Doe", "john@example.com", "1990-01-01", "Male");
+
+    // Create the flight booking system
+    FlightBookingSystem* system = new FlightBookingSystem(&arena);
+    system->addUser(user1);
+    system->addFlight(flight101);
+
+    // Recover bookings from earlier runs and log new ones
+    if (!dataDirectory.empty()) {
+        if (!system->enableDurability(dataDirectory)) {
+            cout << "Could not open booking data in " << dataDirectory << endl;
+            delete system;
+            return 1;
+        }
+        cout << "Bookings are persisted in " << dataDirectory << endl;
+    }
+
+    // Search for flights
+    vector<Schedule*> availableFlights = system->getFlightDetails("Delhi International", "Bangalore International", now);
+    if (!availableFlights.empty()) {
+        cout << "Found " << availableFlights.size() << " flights!" << endl;
+        // Book the first available flight
+        BookingDetails* booking = system->bookFlight(flight101, availableFlights[0], user1, seat1);
+        if (booking) {
+            system->confirmBooking(booking);
+            system->flushConfirmations(); // Keep the demo output in order
+            // Reverse lookup by PNR
+            if (system->findBooking(booking->getPnrNumber()) == booking) {
+                cout << "PNR " << booking->getPnrNumber() << " resolves to the booking" << endl;
+            }
+        } else {
+            cout << "Booking failed: Seat not available" << endl;
+        }
+        // The same seat on the same schedule cannot be booked twice
+        if (!system->bookFlight(flight101, availableFlights[0], user1, seat1)) {
+            cout << "Second booking of seat " << seat1->getSeatNumber() << " rejected" << endl;
+        }
+    } else {
+        cout << "No flights found!" << endl;
+    }
+
+    // Connecting itineraries: add a Delhi -> Mumbai -> Bangalore option
+    Airport* mumbai = arena.create<Airport>("Mumbai International", "Mumbai");
+    Flight* flight202 = arena.create<Flight>("IND202", indigo, 150);
+    Flight* flight303 = arena.create<Flight>("IND303", indigo, 150);
+    flight202->addSeat(arena.create<FlightSeat>("10A", SeatClass::ECONOMY, 3000.0));
+    flight303->addSeat(arena.create<FlightSeat>("10A", SeatClass::ECONOMY, 2500.0));
+    flight202->addSchedule(arena.create<Schedule>(flight202, delhi, mumbai, departure - 600, departure + 3600, ScheduleStatus::ON_TIME));
+    flight303->addSchedule(arena.create<Schedule>(flight303, mumbai, bangalore, departure + 7200, departure + 12600, ScheduleStatus::ON_TIME));
+    system->addFlight(flight202);
+    system->addFlight(flight303);
+    system->buildItineraryIndex();
+    for (const Itinerary& itinerary : system->searchItineraries("Delhi International", "Bangalore International",
+                                                                departure - 3600, 5, ItineraryRank::PRICE)) {
+        cout << "Itinerary (" << itinerary.legs.size() - 1 << " stop(s), price " << itinerary.price << "):";
+        for (Schedule* leg : itinerary.legs) cout << " " << leg->getFlight()->getFlightNumber();
+        cout << endl;
+    }
+
+    // Bulk-load a schedule feed if one was given
+    if (!feedPath.empty()) {
+        const string& path = feedPath;
+        ScheduleLoader loader(*system, arena);
+        LoadStats stats;
+        bool binary = path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+        if (!(binary ? loader.loadBinary(path, stats) : loader.loadCsv(path, stats))) {
+            cout << "Could not load schedule feed: " << path << endl;
+            delete system;
+            return 1;
+        }
+        cout << "Loaded " << stats.rows << " schedules (" << stats.skippedRows << " skipped), "
+             << stats.flights << " flights, " << stats.airports << " airports, "
+             << stats.airlines << " airlines, " << stats.seats << " seats" << endl;
     }
 
+    // Stops the confirmation worker after it has sent everything queued
+    delete system;
     return 0;
 }
\ No newline at end of file
@@ -1,57 +1,624 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
+// Word-level seat-row helpers (bit set = booked, 64 seats per word),
+// shared by the single-hall CinemaBooking and the concurrent ShowSeats
+struct SeatBits {
+    // Mask of the columns [from, to) that fall inside word w
+    static uint64_t rangeMask(int w, int from, int to) {
+        int lo = max(from - w * 64, 0), hi = min(to - w * 64, 64);
+        if (lo >= hi) return 0;
+        uint64_t upper = hi == 64 ? ~0ULL : (1ULL << hi) - 1;
+        return upper & ~((1ULL << lo) - 1);
+    }
+
+    // out[i] = in[i + s] for every bit i (a multi-word right shift)
+    static void shiftDown(const vector<uint64_t>& in, int s, vector<uint64_t>& out) {
+        int n = (int)in.size(), words = s / 64, bits = s % 64;
+        out.assign(n, 0);
+        for (int w = 0; w + words < n; w++) {
+            uint64_t lo = in[w + words] >> bits;
+            uint64_t hi = (bits && w + words + 1 < n) ? in[w + words + 1] << (64 - bits) : 0;
+            out[w] = lo | hi;
+        }
+    }
+
+    // Bit i of 'starts' is set if seats i .. i+k-1 of the row are all free.
+    // Shift-and doubling: after each step a bit covers twice as many seats,
+    // so this takes O(words * log k) word operations.
+    static void blockStarts(const uint64_t* row, int wordsPerRow, int cols, int k, vector<uint64_t>& starts) {
+        starts.resize(wordsPerRow);
+        for (int w = 0; w < wordsPerRow; w++) starts[w] = ~row[w] & rangeMask(w, 0, cols);
+        vector<uint64_t> shifted;
+        for (int covered = 1; covered < k;) {
+            int s = min(covered, k - covered);
+            shiftDown(starts, s, shifted);
+            for (int w = 0; w < wordsPerRow; w++) starts[w] &= shifted[w];
+            covered += s;
+        }
+    }
+
+    // Best-block ranking: closest to the middle row, then block centre closest to the middle column
+    static long long rowPenalty(int r, int rows, int cols) {
+        return (long long)abs(2 * r - (rows - 1)) * cols;
+    }
+
+    // Update (bestScore, bestRow, bestCol) with the k-seat blocks of row r (bestScore < 0 = none yet)
+    static void considerRow(const uint64_t* row, int wordsPerRow, int r, int rows, int cols, int k,
+                            vector<uint64_t>& starts, long long& bestScore, int& bestRow, int& bestCol) {
+        blockStarts(row, wordsPerRow, cols, k, starts);
+        long long penalty = rowPenalty(r, rows, cols);
+        int idealStart = (cols - k) / 2;
+        for (int w = 0; w < wordsPerRow; w++) {
+            for (uint64_t bits = starts[w]; bits; bits &= bits - 1) {
+                int c = w * 64 + __builtin_ctzll(bits);
+                long long score = penalty + abs(c - idealStart);
+                if (bestScore < 0 || score < bestScore) {
+                    bestScore = score;
+                    bestRow = r;
+                    bestCol = c;
+                }
+            }
+        }
+    }
+};
+
+// One seat transition in the journal: 'count' seats from 'firstSeat'
+// (row * cols + col) became booked or free. Fixed 8 bytes, so a torn
+// write at the end of the file is simply a short last record.
+struct JournalRecord {
+    uint32_t firstSeat;
+    uint16_t count;
+    uint8_t booked;   // 1 = booked, 0 = cancelled
+    uint8_t check;    // XOR of the other bytes ^ 0xA5, rejects garbage
+
+    uint8_t computeCheck() const {
+        return (uint8_t)(firstSeat ^ (firstSeat >> 8) ^ (firstSeat >> 16) ^ (firstSeat >> 24) ^
+                         count ^ (count >> 8) ^ booked ^ 0xA5);
+    }
+};
+
+// Header of the seat files: the memory-mapped seat file ("CSMF", followed by
+// rows * wordsPerRow seat words), the journal ("CJNL", followed by
+// JournalRecords) and the older snapshot format ("CSNP", imported once)
+struct SeatFileHeader {
+    char magic[4];
+    uint32_t rows, cols;
+    uint32_t reserved;
+};
+
+// --- Hierarchical timing wheel ---
+// Timers are small ids (indexes into the caller's own table) that fire once
+// the wheel reaches their deadline tick. Four levels of 64 slots: level L
+// holds timers due within 64^(L+1) ticks, in the slot given by the L-th
+// base-64 digit of the deadline. Whenever a level wraps, the matching slot of
+// the level above is cascaded down, so a timer moves at most 3 times before
+// it fires: schedule/cancel are O(1) and expiry is O(1) amortized per timer.
+// No threads: the owner calls advance() with the current tick.
+class TimingWheel {
+public:
+    static const int LEVELS = 4, SLOT_BITS = 6, SLOTS = 1 << SLOT_BITS;
+    static const uint64_t MAX_DELAY = (1ULL << (LEVELS * SLOT_BITS)) - 1;
+
+private:
+    struct Node {
+        uint64_t deadline = 0;
+        int prev = -1, next = -1;
+        int level = -1; // -1 = not scheduled
+        int slot = 0;
+    };
+    vector<Node> nodes;            // indexed by timer id
+    int head[LEVELS][SLOTS];       // intrusive doubly-linked list per slot
+    uint64_t occupied[LEVELS] = {}; // bit s set = slot s is non-empty
+    uint64_t current = 0;
+    size_t pending = 0;
+
+    void link(int id) {
+        Node& n = nodes[id];
+        uint64_t delay = n.deadline - current;
+        int level = 0;
+        while (level < LEVELS - 1 && (delay >> (SLOT_BITS * (level + 1)))) level++;
+        n.level = level;
+        n.slot = (n.deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
+        n.prev = -1;
+        n.next = head[level][n.slot];
+        if (n.next >= 0) nodes[n.next].prev = id;
+        head[level][n.slot] = id;
+        occupied[level] |= 1ULL << n.slot;
+    }
+
+    void unlink(int id) {
+        Node& n = nodes[id];
+        if (n.prev >= 0) nodes[n.prev].next = n.next;
+        else head[n.level][n.slot] = n.next;
+        if (n.next >= 0) nodes[n.next].prev = n.prev;
+        if (head[n.level][n.slot] < 0) occupied[n.level] &= ~(1ULL << n.slot);
+        n.level = -1;
+    }
+
+public:
+    TimingWheel() {
+        for (auto& level : head) fill(begin(level), end(level), -1);
+    }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return pending; }
+    bool scheduled(int id) const { return id < (int)nodes.size() && nodes[id].level >= 0; }
+
+    // (Re)arm timer 'id' for 'deadline', clamped to 1 .. MAX_DELAY ticks ahead
+    void schedule(int id, uint64_t deadline) {
+        if (id >= (int)nodes.size()) nodes.resize(id + 1);
+        if (nodes[id].level >= 0) unlink(id);
+        else pending++;
+        nodes[id].deadline = min(max(deadline, current + 1), current + MAX_DELAY);
+        link(id);
+    }
+
+    void cancel(int id) {
+        if (!scheduled(id)) return;
+        unlink(id);
+        pending--;
+    }
+
+    // Move the wheel forward to tick 'to', calling fire(id) for every timer
+    // that comes due. Empty stretches are skipped a slot run at a time.
+    template <class Fire>
+    void advance(uint64_t to, Fire fire) {
+        while (current < to) {
+            if (!pending) {
+                current = to;
+                return;
+            }
+            // Jump to the next occupied level-0 slot, or to the next wrap
+            int pos = current & (SLOTS - 1);
+            uint64_t ahead = pos == SLOTS - 1 ? 0 : occupied[0] >> (pos + 1);
+            uint64_t step = ahead ? __builtin_ctzll(ahead) + 1 : SLOTS - pos;
+            current = min(to, current + step);
+
+            // Cascade every level that just wrapped, highest first
+            int wrapped = 0;
+            while (wrapped < LEVELS - 1 && !(current & ((1ULL << (SLOT_BITS * (wrapped + 1))) - 1))) wrapped++;
+            for (int level = wrapped; level >= 1; level--) {
+                int slot = (current >> (SLOT_BITS * level)) & (SLOTS - 1);
+                while (head[level][slot] >= 0) {
+                    int id = head[level][slot];
+                    unlink(id);
+                    link(id); // always lands in a lower level
+                }
+            }
+
+            int slot = current & (SLOTS - 1);
+            while (head[0][slot] >= 0) {
+                int id = head[0][slot];
+                unlink(id);
+                pending--;
+                fire(id);
+            }
+        }
+    }
+};
+
 class CinemaBooking {
     int rows, cols;
-    vector<vector<int>> seats; // 0 = free, 1 = booked
+    int wordsPerRow;          // 64 seats per word
+    uint64_t* seats = nullptr; // Row-major bitset: bit set = booked (bits past the last column stay 0)
+    size_t seatWords;         // rows * wordsPerRow
 
-public:
-    // Constructor (with dynamic size)
-    CinemaBooking(int r, int c) : rows(r), cols(c) {
-        seats.assign(rows, vector<int>(cols, 0));
-        loadFromFile(); // try loading previous data
+    // Persistence: <name>.seats is mapped into memory and 'seats' points into
+    // it, so startup is one mmap and a booking dirties only the page holding
+    // its word. The journal records each transition until the next msync.
+    string seatFilePath, snapshotPath, journalPath;
+    void* mapping = nullptr;  // nullptr -> seats live in heapSeats (file unusable)
+    size_t mappingBytes = 0;
+    vector<uint64_t> heapSeats;
+    ofstream journal;
+    size_t journalRecords = 0;
+
+    // Checkout holds: seats kept for a customer while they pay, released by
+    // the timing wheel once the TTL runs out. Held seats have their own
+    // bitset (allocated on the first hold) and never reach the seat file or
+    // journal, so a restart drops them just as if they had expired.
+    struct Hold {
+        int row = 0, startCol = 0, count = 0;
+        uint32_t generation = 0; // bumped on every release, so stale hold ids are rejected
+        bool active = false;
+    };
+    static const int HOLD_TICK_MS = 100;
+    vector<uint64_t> heldSeats;
+    vector<Hold> holds;       // index = timer id in holdTimers
+    vector<int> freeHolds;
+    TimingWheel holdTimers;
+    size_t heldCount = 0;     // seats currently held
+    chrono::steady_clock::time_point clockStart = chrono::steady_clock::now();
+
+    // --- Bit helpers ---
+    uint64_t* rowWords(int r) { return &seats[(size_t)r * wordsPerRow]; }
+    const uint64_t* rowWords(int r) const { return &seats[(size_t)r * wordsPerRow]; }
+
+    bool isBooked(int r, int c) const {
+        return (rowWords(r)[c / 64] >> (c % 64)) & 1;
     }
 
-    // --- Save & Load from File ---
-    void saveToFile() {
-        ofstream out("seats.txt");
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                out << seats[i][j] << " ";
+    bool isHeld(int r, int c) const {
+        return heldCount && (heldSeats[(size_t)r * wordsPerRow + c / 64] >> (c % 64)) & 1;
+    }
+
+    // Row words with held seats counted as taken (the seat words themselves when nothing is held)
+    const uint64_t* takenRow(int r, vector<uint64_t>& buf) const {
+        if (!heldCount) return rowWords(r);
+        buf.resize(wordsPerRow);
+        for (int w = 0; w < wordsPerRow; w++) buf[w] = rowWords(r)[w] | heldSeats[(size_t)r * wordsPerRow + w];
+        return buf.data();
+    }
+
+    void setBooked(int r, int c, bool booked) {
+        uint64_t bit = 1ULL << (c % 64);
+        if (booked) rowWords(r)[c / 64] |= bit;
+        else rowWords(r)[c / 64] &= ~bit;
+    }
+
+    // Book or free seats [startCol, startCol + count) of a row (range already validated)
+    void setRange(int row, int startCol, int count, bool booked) {
+        uint64_t* words = rowWords(row);
+        for (int w = startCol / 64; w <= (startCol + count - 1) / 64; w++) {
+            uint64_t mask = SeatBits::rangeMask(w, startCol, startCol + count);
+            if (booked) words[w] |= mask;
+            else words[w] &= ~mask;
+        }
+    }
+
+    // Append one transition (8 bytes) and compact once the journal outgrows the snapshot
+    void logChange(int row, int startCol, int count, bool booked) {
+        JournalRecord rec;
+        rec.firstSeat = (uint32_t)row * cols + startCol;
+        rec.count = (uint16_t)count;
+        rec.booked = booked;
+        rec.check = rec.computeCheck();
+        journal.write((const char*)&rec, sizeof(rec));
+        journal.flush();
+        if (++journalRecords >= max<size_t>(1024, seatWords)) saveToFile();
+    }
+
+    // Map <name>.seats (creating it for a new hall); returns false if it is new
+    // or could not be used, in which case older formats are imported
+    bool mapSeatFile() {
+        size_t bytes = sizeof(SeatFileHeader) + seatWords * sizeof(uint64_t);
+        int fd = open(seatFilePath.c_str(), O_RDWR | O_CREAT, 0644);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            cout << "[ERROR] " << seatFilePath << " cannot be opened, keeping seats in memory.\n";
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        bool created = st.st_size == 0;
+        if ((created && ftruncate(fd, bytes) != 0) || (!created && (size_t)st.st_size != bytes)) {
+            cout << "[ERROR] " << seatFilePath << " cannot be used for this hall, keeping seats in memory.\n";
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd); // the mapping keeps the file open
+        if (addr == MAP_FAILED) return false;
+
+        SeatFileHeader* header = (SeatFileHeader*)addr;
+        SeatFileHeader expected = {{'C', 'S', 'M', 'F'}, (uint32_t)rows, (uint32_t)cols, 0};
+        if (created) {
+            *header = expected; // the file is zero-filled: every seat starts free
+        } else if (string(header->magic, 4) != "CSMF" || header->rows != expected.rows || header->cols != expected.cols) {
+            cout << "[ERROR] " << seatFilePath << " does not match this hall, keeping seats in memory.\n";
+            munmap(addr, bytes);
+            return false;
+        }
+        mapping = addr;
+        mappingBytes = bytes;
+        seats = (uint64_t*)((char*)addr + sizeof(SeatFileHeader));
+        return !created;
+    }
+
+    // One-time import of the older snapshot format (<name>.snap)
+    bool importSnapshot() {
+        ifstream in(snapshotPath, ios::binary);
+        if (!in) return false;
+        SeatFileHeader header;
+        if (!in.read((char*)&header, sizeof(header)) || string(header.magic, 4) != "CSNP" ||
+            (int)header.rows != rows || (int)header.cols != cols) {
+            cout << "[ERROR] " << snapshotPath << " does not match this hall, ignoring it.\n";
+            return false;
+        }
+        in.read((char*)seats, seatWords * sizeof(uint64_t));
+        return true;
+    }
+
+    // Start an empty journal (header only)
+    void openNewJournal() {
+        journal.close();
+        journal.open(journalPath, ios::binary | ios::trunc);
+        SeatFileHeader header = {{'C', 'J', 'N', 'L'}, (uint32_t)rows, (uint32_t)cols, 0};
+        journal.write((const char*)&header, sizeof(header));
+        journal.flush();
+        journalRecords = 0;
+    }
+
+    // Re-apply every complete, valid journal record (replay is idempotent).
+    // 'usable' is false if there is no journal for this hall; returns false
+    // if the journal ends in a torn or bad record.
+    bool replayJournal(bool& usable) {
+        ifstream in(journalPath, ios::binary);
+        SeatFileHeader header;
+        usable = false;
+        if (!in.read((char*)&header, sizeof(header))) return true;
+        if (string(header.magic, 4) != "CJNL" || (int)header.rows != rows || (int)header.cols != cols) {
+            cout << "[ERROR] " << journalPath << " does not match this hall, ignoring it.\n";
+            return true;
+        }
+        usable = true;
+        JournalRecord rec;
+        bool clean = true;
+        while (in.read((char*)&rec, sizeof(rec))) {
+            // A hall without columns has no valid record (and nothing to divide by)
+            uint32_t row = cols > 0 ? rec.firstSeat / cols : 0, col = cols > 0 ? rec.firstSeat % cols : 0;
+            if (cols <= 0 || rec.check != rec.computeCheck() || row >= (uint32_t)rows || rec.count == 0 ||
+                col + rec.count > (uint32_t)cols) {
+                clean = false;
+                continue;
             }
-            out << "\n";
+            setRange((int)row, (int)col, rec.count, rec.booked);
+            journalRecords++;
         }
-        out.close();
+        return clean && in.gcount() == 0;
     }
 
-    void loadFromFile() {
+    // One-time import of the old text format (seats.txt)
+    bool importTextFile() {
         ifstream in("seats.txt");
-        if (!in) return; // file doesn't exist
+        if (!in) return false;
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                in >> seats[i][j];
+                int booked = 0;
+                in >> booked;
+                setBooked(i, j, booked == 1);
             }
         }
-        in.close();
+        return true;
+    }
+
+    // --- Hold helpers ---
+    uint64_t currentTick() const {
+        auto elapsed = chrono::steady_clock::now() - clockStart;
+        return chrono::duration_cast<chrono::milliseconds>(elapsed).count() / HOLD_TICK_MS;
+    }
+
+    // Hold id = generation in the high 32 bits, slot in the low 32; -1 if stale
+    int findHold(long long holdId) const {
+        if (holdId < 0) return -1;
+        int slot = (int)(holdId & 0xFFFFFFFF);
+        if (slot >= (int)holds.size() || !holds[slot].active || holds[slot].generation != (uint32_t)(holdId >> 32)) return -1;
+        return slot;
+    }
+
+    // Free a hold's seats and recycle its slot (its timer is already cancelled or fired)
+    void dropHold(int slot) {
+        Hold& h = holds[slot];
+        uint64_t* words = &heldSeats[(size_t)h.row * wordsPerRow];
+        for (int w = h.startCol / 64; w <= (h.startCol + h.count - 1) / 64; w++) {
+            words[w] &= ~SeatBits::rangeMask(w, h.startCol, h.startCol + h.count);
+        }
+        heldCount -= h.count;
+        h.active = false;
+        h.generation++;
+        freeHolds.push_back(slot);
+    }
+
+public:
+    // Constructor (with dynamic size); data lives in <name>.seats and <name>.journal
+    CinemaBooking(int r, int c, const string& name = "seats")
+        : rows(r), cols(c), seatFilePath(name + ".seats"), snapshotPath(name + ".snap"),
+          journalPath(name + ".journal") {
+        wordsPerRow = (cols + 63) / 64;
+        seatWords = (size_t)rows * wordsPerRow;
+        loadFromFile(); // try loading previous data
+    }
+
+    // Flush on a clean exit, so the next start has an empty journal
+    ~CinemaBooking() {
+        saveToFile();
+        if (mapping) munmap(mapping, mappingBytes);
+    }
+
+    CinemaBooking(const CinemaBooking&) = delete;
+    CinemaBooking& operator=(const CinemaBooking&) = delete;
+
+    // --- Save & Load from File ---
+    // Compaction: write the dirty pages of the seat file back (msync only
+    // touches pages that changed), then start an empty journal.
+    void saveToFile() {
+        if (!mapping) return; // no seat file: the journal is the only copy, keep it
+        if (msync(mapping, mappingBytes, MS_SYNC) != 0) {
+            cout << "[ERROR] Could not write " << seatFilePath << "\n";
+            return;
+        }
+        openNewJournal();
+    }
+
+    // Map the seat file and replay the journal tail; a new seat file imports
+    // the older .snap or seats.txt formats once
+    void loadFromFile() {
+        bool existing = mapSeatFile(), usable;
+        if (!mapping) {
+            heapSeats.assign(seatWords, 0);
+            seats = heapSeats.data();
+        }
+        bool imported = !existing && (importSnapshot() || importTextFile());
+        bool clean = replayJournal(usable);
+        if (usable) journal.open(journalPath, ios::binary | ios::app);
+        else openNewJournal();
+        if (imported || !clean) saveToFile(); // also keeps new records from following a torn one
     }
 
     // --- Helper: Check if seat valid ---
-    bool isValidSeat(int r, int c) {
+    bool isValidSeat(int r, int c) const {
         return (r >= 0 && r < rows && c >= 0 && c < cols);
     }
 
+    // --- Seat operations (0-based, each change is journaled) ---
+    // Updates expire due holds first; the read-only queries below see holds
+    // as of the last expireHolds() call.
+    bool bookSeat(int r, int c) {
+        expireHolds();
+        if (!isValidSeat(r, c) || isBooked(r, c) || isHeld(r, c)) return false;
+        setBooked(r, c, true);
+        logChange(r, c, 1, true);
+        return true;
+    }
+
+    bool cancelBooking(int r, int c) {
+        if (!isValidSeat(r, c) || !isBooked(r, c)) return false;
+        setBooked(r, c, false);
+        logChange(r, c, 1, false);
+        return true;
+    }
+
+    // True if seats [startCol, startCol + count) of the row are neither booked
+    // nor held (one AND per word)
+    bool isBlockFree(int row, int startCol, int count) const {
+        if (row < 0 || row >= rows || startCol < 0 || count <= 0 || startCol + count > cols) return false;
+        const uint64_t* words = rowWords(row);
+        const uint64_t* held = heldCount ? &heldSeats[(size_t)row * wordsPerRow] : nullptr;
+        for (int w = startCol / 64; w <= (startCol + count - 1) / 64; w++) {
+            uint64_t taken = held ? words[w] | held[w] : words[w];
+            if (taken & SeatBits::rangeMask(w, startCol, startCol + count)) return false;
+        }
+        return true;
+    }
+
+    bool bookBlock(int row, int startCol, int count) {
+        expireHolds();
+        if (count > UINT16_MAX || !isBlockFree(row, startCol, count)) return false;
+        setRange(row, startCol, count, true);
+        logChange(row, startCol, count, true);
+        return true;
+    }
+
+    // --- Checkout holds ---
+    // Release every hold whose TTL has run out (O(1) amortized per hold)
+    void expireHolds() {
+        holdTimers.advance(currentTick(), [this](int slot) { dropHold(slot); });
+    }
+
+    // Hold seats [startCol, startCol + count) of a row for ttlSeconds while the
+    // customer pays. Returns a hold id for confirmHold/releaseHold, or -1.
+    long long holdBlock(int row, int startCol, int count, int ttlSeconds) {
+        expireHolds();
+        if (count > UINT16_MAX || ttlSeconds <= 0 || !isBlockFree(row, startCol, count)) return -1;
+        if (heldSeats.empty()) heldSeats.assign(seatWords, 0);
+
+        int slot;
+        if (!freeHolds.empty()) {
+            slot = freeHolds.back();
+            freeHolds.pop_back();
+        } else {
+            slot = (int)holds.size();
+            holds.emplace_back();
+        }
+        Hold& h = holds[slot];
+        h.row = row;
+        h.startCol = startCol;
+        h.count = count;
+        h.active = true;
+        uint64_t* words = &heldSeats[(size_t)row * wordsPerRow];
+        for (int w = startCol / 64; w <= (startCol + count - 1) / 64; w++) {
+            words[w] |= SeatBits::rangeMask(w, startCol, startCol + count);
+        }
+        heldCount += count;
+
+        uint64_t ttlTicks = ((uint64_t)ttlSeconds * 1000 + HOLD_TICK_MS - 1) / HOLD_TICK_MS;
+        holdTimers.schedule(slot, holdTimers.now() + ttlTicks);
+        return ((long long)h.generation << 32) | slot;
+    }
+
+    // Payment went through: book the held seats. False if the hold expired.
+    bool confirmHold(long long holdId) {
+        expireHolds();
+        int slot = findHold(holdId);
+        if (slot < 0) return false;
+        Hold h = holds[slot];
+        holdTimers.cancel(slot);
+        dropHold(slot);
+        setRange(h.row, h.startCol, h.count, true);
+        logChange(h.row, h.startCol, h.count, true);
+        return true;
+    }
+
+    // Customer left checkout: free the seats now instead of waiting for the TTL
+    bool releaseHold(long long holdId) {
+        expireHolds();
+        int slot = findHold(holdId);
+        if (slot < 0) return false;
+        holdTimers.cancel(slot);
+        dropHold(slot);
+        return true;
+    }
+
+    int countHeldSeats() const { return (int)heldCount; }
+
+    // First column where k free seats in a row start, or -1
+    int findFirstBlock(int row, int k) const {
+        if (row < 0 || row >= rows || k <= 0 || k > cols) return -1;
+        vector<uint64_t> starts, buf;
+        SeatBits::blockStarts(takenRow(row, buf), wordsPerRow, cols, k, starts);
+        for (int w = 0; w < wordsPerRow; w++) {
+            if (starts[w]) return w * 64 + __builtin_ctzll(starts[w]);
+        }
+        return -1;
+    }
+
+    // Best block of k free seats in the hall: closest to the middle row,
+    // then with its centre closest to the middle column. False if none.
+    bool findBestBlock(int k, int& bestRow, int& bestCol) const {
+        if (k <= 0 || k > cols) return false;
+        long long bestScore = -1;
+        vector<uint64_t> starts, buf;
+        for (int r = 0; r < rows; r++) {
+            if (bestScore >= 0 && SeatBits::rowPenalty(r, rows, cols) > bestScore) continue; // cannot beat the current best
+            SeatBits::considerRow(takenRow(r, buf), wordsPerRow, r, rows, cols, k, starts, bestScore, bestRow, bestCol);
+        }
+        return bestScore >= 0;
+    }
+
+    int countFreeSeats() const {
+        int booked = 0;
+        for (size_t i = 0; i < seatWords; i++) booked += __builtin_popcountll(seats[i]);
+        return rows * cols - booked - (int)heldCount;
+    }
+
     // --- View Seats ---
     void viewSeats() {
-        cout << "\n--- Seat Layout (0 = Free, 1 = Booked) ---\n   ";
+        cout << "\n--- Seat Layout (0 = Free, 1 = Booked, H = Held) ---\n   ";
         for (int j = 0; j < cols; j++) cout << j + 1 << " ";
         cout << "\n";
 
         for (int i = 0; i < rows; i++) {
             cout << i + 1 << " | ";
             for (int j = 0; j < cols; j++) {
-                cout << seats[i][j] << " ";
+                if (isHeld(i, j)) cout << "H ";
+                else cout << isBooked(i, j) << " ";
             }
             cout << "\n";
         }
@@ -64,10 +631,8 @@ public:
         cin >> r >> c;
         r--, c--; // convert to 0-based
 
-        if (isValidSeat(r, c) && seats[r][c] == 0) {
-            seats[r][c] = 1;
+        if (bookSeat(r, c)) {
             cout << "[OK] Seat booked successfully.\n";
-            saveToFile();
         } else {
             cout << "[ERROR] Invalid or already booked.\n";
         }
@@ -81,18 +646,9 @@ public:
         cin >> row >> startCol >> count;
         row--, startCol--; // convert to 0-based
 
-        if (row >= 0 && row < rows && startCol >= 0 && startCol + count <= cols) {
-            bool canBook = true;
-            for (int i = 0; i < count; i++) {
-                if (seats[row][startCol + i] == 1) {
-                    canBook = false;
-                    break;
-                }
-            }
-            if (canBook) {
-                for (int i = 0; i < count; i++) seats[row][startCol + i] = 1;
+        if (row >= 0 && row < rows && startCol >= 0 && count > 0 && startCol + count <= cols) {
+            if (bookBlock(row, startCol, count)) {
                 cout << "[OK] Block booked successfully.\n";
-                saveToFile();
             } else {
                 cout << "[ERROR] Some seats already booked.\n";
             }
@@ -109,10 +665,8 @@ public:
         cin >> r >> c;
         r--, c--;
 
-        if (isValidSeat(r, c) && seats[r][c] == 1) {
-            seats[r][c] = 0;
+        if (cancelBooking(r, c)) {
             cout << "[OK] Booking cancelled.\n";
-            saveToFile();
         } else {
             cout << "[ERROR] Invalid seat or not booked.\n";
         }
@@ -125,7 +679,7 @@ public:
         bool found = false;
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                if (seats[i][j] == 0) {
+                if (!isBooked(i, j) && !isHeld(i, j)) {
                     cout << "Seat (" << i + 1 << "," << j + 1 << ") is free\n";
                     found = true;
                 }
@@ -133,9 +687,368 @@ public:
         }
         if (!found) cout << "No seats available.\n";
     }
+
+    // --- Find Seats for a Group ---
+    void findGroupSeats() {
+        int k, row;
+        cout << "Enter group size and row (1-based, 0 = best in hall): ";
+        cin >> k >> row;
+
+        int r = row - 1, c = -1;
+        if (row == 0) {
+            findBestBlock(k, r, c); // leaves c = -1 if nothing fits
+        } else {
+            c = findFirstBlock(r, k);
+        }
+        if (c >= 0) {
+            cout << "[OK] " << k << " free seats together: row " << r + 1
+                 << ", seats " << c + 1 << "-" << c + k << "\n";
+        } else {
+            cout << "[ERROR] No block of " << k << " free seats found.\n";
+        }
+    }
+
+    // --- Hold Seats for Checkout ---
+    void holdSeats() {
+        int row, startCol, count, ttl;
+        cout << "Enter row, starting column, number of seats (1-based) and hold time in seconds: ";
+        cin >> row >> startCol >> count >> ttl;
+
+        long long holdId = holdBlock(row - 1, startCol - 1, count, ttl);
+        if (holdId >= 0) {
+            cout << "[OK] Seats held for " << ttl << " s. Hold id: " << holdId << "\n";
+        } else {
+            cout << "[ERROR] Invalid input or seats not free.\n";
+        }
+        viewSeats();
+    }
+
+    // --- Complete Checkout ---
+    void completeCheckout() {
+        long long holdId;
+        int paid;
+        cout << "Enter hold id and 1 if paid (0 to release the seats): ";
+        cin >> holdId >> paid;
+
+        if (paid ? confirmHold(holdId) : releaseHold(holdId)) {
+            cout << (paid ? "[OK] Held seats booked.\n" : "[OK] Held seats released.\n");
+        } else {
+            cout << "[ERROR] Unknown or expired hold.\n";
+        }
+        viewSeats();
+    }
+};
+
+// --- Concurrent seat map for one show ---
+// Same bit layout as CinemaBooking, but every word is an atomic and all
+// updates are compare-and-swap on the affected words: no locks, so
+// thousands of clients can book the same show at once. A request that
+// touches several words claims them in address order and rolls back on
+// the first conflict (all-or-nothing, never blocks or deadlocks).
+class ShowSeats {
+    int rows, cols, wordsPerRow;
+    unique_ptr<atomic<uint64_t>[]> words;
+
+    // Set 'mask' in word w if none of its bits is set yet
+    bool claim(size_t w, uint64_t mask) {
+        uint64_t current = words[w].load(memory_order_relaxed);
+        do {
+            if (current & mask) return false;
+        } while (!words[w].compare_exchange_weak(current, current | mask, memory_order_acq_rel, memory_order_relaxed));
+        return true;
+    }
+
+    // Claim every (word, mask) pair or none of them; pairs are sorted by word
+    bool claimAll(const vector<pair<size_t, uint64_t>>& parts) {
+        for (size_t i = 0; i < parts.size(); i++) {
+            if (!claim(parts[i].first, parts[i].second)) {
+                while (i-- > 0) words[parts[i].first].fetch_and(~parts[i].second, memory_order_release);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // (word, mask) pairs covering seats [startCol, startCol + count) of a row
+    void blockParts(int row, int startCol, int count, vector<pair<size_t, uint64_t>>& parts) const {
+        parts.clear();
+        for (int w = startCol / 64; w <= (startCol + count - 1) / 64; w++) {
+            parts.emplace_back((size_t)row * wordsPerRow + w, SeatBits::rangeMask(w, startCol, startCol + count));
+        }
+    }
+
+    // Copy of a row's words (a consistent-enough view for searching; booking re-checks)
+    void loadRow(int r, vector<uint64_t>& out) const {
+        out.resize(wordsPerRow);
+        for (int w = 0; w < wordsPerRow; w++) out[w] = words[(size_t)r * wordsPerRow + w].load(memory_order_acquire);
+    }
+
+public:
+    ShowSeats(int r, int c) : rows(r), cols(c), wordsPerRow((c + 63) / 64),
+                              words(new atomic<uint64_t>[(size_t)r * ((c + 63) / 64)]) {
+        for (size_t i = 0; i < (size_t)rows * wordsPerRow; i++) words[i].store(0, memory_order_relaxed);
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    bool isValidSeat(int r, int c) const {
+        return (r >= 0 && r < rows && c >= 0 && c < cols);
+    }
+
+    bool isValidBlock(int row, int startCol, int count) const {
+        return row >= 0 && row < rows && startCol >= 0 && count > 0 && startCol + count <= cols;
+    }
+
+    bool isBooked(int r, int c) const {
+        return (words[(size_t)r * wordsPerRow + c / 64].load(memory_order_acquire) >> (c % 64)) & 1;
+    }
+
+    // Book seats [startCol, startCol + count) of a row, all or nothing
+    bool bookBlock(int row, int startCol, int count) {
+        if (!isValidBlock(row, startCol, count)) return false;
+        vector<pair<size_t, uint64_t>> parts;
+        blockParts(row, startCol, count, parts);
+        return claimAll(parts);
+    }
+
+    // Book any set of seats (e.g. a group's picks across rows), all or nothing
+    bool bookSeats(const vector<pair<int, int>>& seatList) {
+        vector<pair<size_t, uint64_t>> parts;
+        for (const pair<int, int>& seat : seatList) {
+            if (!isValidSeat(seat.first, seat.second)) return false;
+            parts.emplace_back((size_t)seat.first * wordsPerRow + seat.second / 64, 1ULL << (seat.second % 64));
+        }
+        // Merge seats that share a word; a seat listed twice cannot be booked twice
+        sort(parts.begin(), parts.end());
+        size_t merged = 0;
+        for (size_t i = 0; i < parts.size(); i++) {
+            if (merged > 0 && parts[merged - 1].first == parts[i].first) {
+                if (parts[merged - 1].second & parts[i].second) return false;
+                parts[merged - 1].second |= parts[i].second;
+            } else {
+                parts[merged++] = parts[i];
+            }
+        }
+        parts.resize(merged);
+        return claimAll(parts);
+    }
+
+    // Free the booked seats of a block; returns how many were booked
+    int cancelBlock(int row, int startCol, int count) {
+        if (!isValidBlock(row, startCol, count)) return 0;
+        vector<pair<size_t, uint64_t>> parts;
+        blockParts(row, startCol, count, parts);
+        int freed = 0;
+        for (const pair<size_t, uint64_t>& part : parts) {
+            uint64_t before = words[part.first].fetch_and(~part.second, memory_order_acq_rel);
+            freed += __builtin_popcountll(before & part.second);
+        }
+        return freed;
+    }
+
+    // Find the best free block of k seats and book it; retries when another client wins the race
+    bool bookBestBlock(int k, int& bestRow, int& bestCol) {
+        if (k <= 0 || k > cols) return false;
+        vector<uint64_t> row, starts;
+        for (int attempt = 0; attempt < 16; attempt++) {
+            long long bestScore = -1;
+            for (int r = 0; r < rows; r++) {
+                if (bestScore >= 0 && SeatBits::rowPenalty(r, rows, cols) > bestScore) continue;
+                loadRow(r, row);
+                SeatBits::considerRow(row.data(), wordsPerRow, r, rows, cols, k, starts, bestScore, bestRow, bestCol);
+            }
+            if (bestScore < 0) return false;             // sold out for this group size
+            if (bookBlock(bestRow, bestCol, k)) return true; // else someone took it first: search again
+        }
+        return false;
+    }
+
+    int countFreeSeats() const {
+        int booked = 0;
+        for (size_t i = 0; i < (size_t)rows * wordsPerRow; i++) {
+            booked += __builtin_popcountll(words[i].load(memory_order_relaxed));
+        }
+        return rows * cols - booked;
+    }
+};
+
+// One request in a batch: 'count' seats from (row, startCol) of a show
+struct SeatRequest {
+    int showId;
+    int row, startCol, count;
+};
+
+// --- Multi-hall, multi-show booking service ---
+// Halls and shows are registered up front (rare, under a mutex); after that
+// every booking call is lock-free: the show is found through an atomic
+// chunk directory and its ShowSeats uses CAS on seat words. Different shows
+// never touch the same memory, and clients of one show only collide on the
+// words they actually book.
+class CinemaService {
+    struct Hall {
+        string name;
+        int rows, cols;
+    };
+
+    struct Show {
+        int hallId;
+        string title;
+        ShowSeats seats;
+        Show(int hallId, const string& title, int rows, int cols)
+            : hallId(hallId), title(title), seats(rows, cols) {}
+    };
+
+    static const int CHUNK_SHOWS = 1024;   // shows per directory chunk
+    static const int MAX_CHUNKS = 4096;    // up to 4M shows
+
+    mutex registryMutex;                   // guards halls and adding shows
+    vector<Hall> halls;
+    unique_ptr<atomic<Show*>[]> chunks[MAX_CHUNKS];
+    atomic<int> showCount{0};
+
+    Show* findShow(int showId) const {
+        if (showId < 0 || showId >= showCount.load(memory_order_acquire)) return nullptr;
+        return chunks[showId / CHUNK_SHOWS][showId % CHUNK_SHOWS].load(memory_order_acquire);
+    }
+
+public:
+    CinemaService() {}
+
+    ~CinemaService() {
+        int count = showCount.load();
+        for (int id = 0; id < count; id++) delete findShow(id);
+    }
+
+    // Register a hall layout; returns its id, or -1 if rows or cols is not positive
+    int addHall(const string& name, int rows, int cols) {
+        if (rows <= 0 || cols <= 0) return -1;
+        lock_guard<mutex> lock(registryMutex);
+        halls.push_back({name, rows, cols});
+        return (int)halls.size() - 1;
+    }
+
+    // Schedule a show in a hall; returns its id, or -1 for an unknown hall or a full directory
+    int addShow(int hallId, const string& title) {
+        lock_guard<mutex> lock(registryMutex);
+        int id = showCount.load(memory_order_relaxed);
+        if (hallId < 0 || hallId >= (int)halls.size() || id >= CHUNK_SHOWS * MAX_CHUNKS) return -1;
+        if (!chunks[id / CHUNK_SHOWS]) {
+            chunks[id / CHUNK_SHOWS].reset(new atomic<Show*>[CHUNK_SHOWS]);
+            for (int i = 0; i < CHUNK_SHOWS; i++) chunks[id / CHUNK_SHOWS][i].store(nullptr, memory_order_relaxed);
+        }
+        const Hall& hall = halls[hallId];
+        chunks[id / CHUNK_SHOWS][id % CHUNK_SHOWS].store(new Show(hallId, title, hall.rows, hall.cols), memory_order_release);
+        showCount.store(id + 1, memory_order_release);
+        return id;
+    }
+
+    int getShowCount() const { return showCount.load(memory_order_acquire); }
+
+    // --- Single requests ---
+    bool bookBlock(int showId, int row, int startCol, int count) {
+        Show* show = findShow(showId);
+        return show && show->seats.bookBlock(row, startCol, count);
+    }
+
+    bool bookSeats(int showId, const vector<pair<int, int>>& seatList) {
+        Show* show = findShow(showId);
+        return show && show->seats.bookSeats(seatList);
+    }
+
+    int cancelBlock(int showId, int row, int startCol, int count) {
+        Show* show = findShow(showId);
+        return show ? show->seats.cancelBlock(row, startCol, count) : 0;
+    }
+
+    bool bookBestBlock(int showId, int k, int& row, int& col) {
+        Show* show = findShow(showId);
+        return show && show->seats.bookBestBlock(k, row, col);
+    }
+
+    int countFreeSeats(int showId) const {
+        Show* show = findShow(showId);
+        return show ? show->seats.countFreeSeats() : 0;
+    }
+
+    // --- Batch API: each request is independent and all-or-nothing ---
+    // booked[i] = 1 if requests[i] was booked
+    void bookBatch(const vector<SeatRequest>& requests, vector<char>& booked) {
+        booked.assign(requests.size(), 0);
+        for (size_t i = 0; i < requests.size(); i++) {
+            const SeatRequest& req = requests[i];
+            booked[i] = bookBlock(req.showId, req.row, req.startCol, req.count);
+        }
+    }
+
+    // freed[i] = seats of requests[i] that were booked and are now free
+    void cancelBatch(const vector<SeatRequest>& requests, vector<int>& freed) {
+        freed.assign(requests.size(), 0);
+        for (size_t i = 0; i < requests.size(); i++) {
+            const SeatRequest& req = requests[i];
+            freed[i] = cancelBlock(req.showId, req.row, req.startCol, req.count);
+        }
+    }
 };
 
-int main() {
+// --- Opening-night load test: many clients hammer one show at once ---
+// Every client thread books random blocks (and sometimes cancels its own);
+// at the end the seats booked must equal what the clients think they own.
+void runOpeningNight(int clients) {
+    CinemaService service;
+    int hall = service.addHall("IMAX 1", 40, 120);
+    for (int i = 0; i < 999; i++) service.addShow(hall, "Matinee " + to_string(i)); // background shows
+    int show = service.addShow(hall, "Opening Night");
+
+    atomic<long long> ownedSeats{0}, attempts{0};
+    auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int t = 0; t < clients; t++) {
+        pool.emplace_back([&, t]() {
+            mt19937 rng(t + 1);
+            vector<SeatRequest> batch, mine;
+            vector<char> booked;
+            long long owned = 0;
+            for (int round = 0; round < 200; round++) {
+                batch.clear();
+                for (int i = 0; i < 8; i++) {
+                    batch.push_back({show, (int)(rng() % 40), (int)(rng() % 118), 1 + (int)(rng() % 3)});
+                }
+                service.bookBatch(batch, booked);
+                for (size_t i = 0; i < batch.size(); i++) {
+                    if (booked[i]) {
+                        owned += batch[i].count;
+                        mine.push_back(batch[i]);
+                    }
+                }
+                if (!mine.empty() && rng() % 4 == 0) { // change of plans: cancel one booking
+                    SeatRequest req = mine.back();
+                    mine.pop_back();
+                    owned -= service.cancelBlock(req.showId, req.row, req.startCol, req.count);
+                }
+            }
+            int row, col;
+            if (service.bookBestBlock(show, 2, row, col)) owned += 2;
+            ownedSeats += owned;
+            attempts += 200 * 8;
+        });
+    }
+    for (thread& client : pool) client.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long booked = 40 * 120 - service.countFreeSeats(show);
+    cout << "[OK] " << clients << " clients, " << attempts.load() << " block requests in " << seconds << " s\n";
+    cout << (booked == ownedSeats.load() ? "[OK]" : "[ERROR]") << " Seats booked: " << booked
+         << ", seats owned by clients: " << ownedSeats.load() << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    // --opening-night N: concurrent service load test with N clients instead of the menu
+    if (argc == 3 && string(argv[1]) == "--opening-night") {
+        runOpeningNight(atoi(argv[2]));
+        return 0;
+    }
+
     int rows = 5, cols = 7;
     CinemaBooking cinema(rows, cols);
 
@@ -147,9 +1060,13 @@ int main() {
         cout << "3. Book a Block of Seats\n";
         cout << "4. Cancel a Seat Booking\n";
         cout << "5. Display Available Seats Only\n";
-        cout << "6. Exit\n";
+        cout << "6. Find Seats for a Group\n";
+        cout << "7. Hold Seats for Checkout\n";
+        cout << "8. Complete Checkout (pay or release a hold)\n";
+        cout << "9. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;
+        cinema.expireHolds(); // release holds that ran out while the menu waited
 
         switch (choice) {
             case 1: cinema.viewSeats(); break;
@@ -157,7 +1074,10 @@ int main() {
             case 3: cinema.bookBlockSeats(); break;
             case 4: cinema.cancelSeat(); break;
             case 5: cinema.displayAvailableSeats(); break;
-            case 6:
+            case 6: cinema.findGroupSeats(); break;
+            case 7: cinema.holdSeats(); break;
+            case 8: cinema.completeCheckout(); break;
+            case 9:
                 cout << "Exiting system. Thank you!\n";
                 return 0;
             default:
@@ -171,7 +1091,7 @@ int main() {
 
 Class-based → no global variables, cleaner code.
 
-File persistence → bookings saved in seats.txt (reopens later with same data).
+File persistence → bookings saved in <name>.seats (reopens later with same data; an old seats.txt or .snap is imported once).
 
 1-based indexing → user-friendly.
 
@@ -180,4 +1100,14 @@ Auto layout refresh → after booking/cancel.
 Helper function (isValidSeat) → reduces repetition.
 
 UX upgrade → clear messages, [OK] / [ERROR] icons.
+
+Bit-packed seats → 1 bit per seat, block checks and group searches a word (64 seats) at a time.
+
+Memory-mapped seat file → <name>.seats is mapped and the seat bitset lives in it: startup is one mmap with no parsing, and a booking updates the file in place.
+
+Journal → each booking also appends 8 bytes to <name>.journal; compaction is an msync of the dirty pages of the seat file plus an empty journal, and a restart replays the journal tail.
+
+CinemaService → many halls and shows at once, lock-free CAS on seat words, batch book/cancel.
+
+Checkout holds → seats held with a TTL while paying, released by a hierarchical timing wheel (no per-seat timers or threads).
  */
\ No newline at end of file